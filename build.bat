@@ -9,10 +9,33 @@ g++ -std=c++17 -Wall -Wextra -O2 ^
     src/algorithms/SJF.cpp ^
     src/algorithms/RoundRobin.cpp ^
     src/algorithms/Priority.cpp ^
+    src/algorithms/Gang.cpp ^
+    src/algorithms/GroupScheduler.cpp ^
     src/core/CPU.cpp ^
+    src/core/Workload.cpp ^
     src/core/Statistics.cpp ^
+    src/core/ResultsTable.cpp ^
+    src/core/AnalyticSolver.cpp ^
+    src/core/QuantumTuner.cpp ^
+    src/core/ReplicationRunner.cpp ^
+    src/core/Profiler.cpp ^
+    src/core/TimeSeriesSampler.cpp ^
+    src/core/TraceIndex.cpp ^
+    src/core/Checkpoint.cpp ^
+    src/core/IncrementalSimulator.cpp ^
+    src/core/ResultCache.cpp ^
+    src/core/FusedSimulation.cpp ^
+    src/core/PartitionedSimulation.cpp ^
+    src/core/SweepRunner.cpp ^
     src/visualization/GanttChart.cpp ^
+    src/visualization/ChromeTraceWriter.cpp ^
     src/utils/InputGenerator.cpp ^
+    src/utils/ArrivalStream.cpp ^
+    src/utils/LinuxTraceImporter.cpp ^
+    src/utils/AsyncWriter.cpp ^
+    src/utils/WorkloadGenerator.cpp ^
+    src/utils/AllocationCounter.cpp ^
+    src/utils/BinaryTrace.cpp ^
     -o scheduler.exe
 
 if %errorlevel% equ 0 (
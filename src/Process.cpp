@@ -1,27 +1,29 @@
 #include "Process.h"
+#include "core/Checkpoint.h"
 #include <iostream>
 #include <iomanip>
 #include <sstream>
 #include <algorithm>
+#include <stdexcept>
 
 Process::Process() : processID(0), processName("P0"), arrivalTime(0), burstTime(0), 
-                     remainingTime(0), priority(0), startTime(-1), completionTime(-1), 
+                     remainingTime(0), workCredit(0.0), priority(0), width(1), startTime(-1), completionTime(-1),
                      waitingTime(0), turnaroundTime(0), responseTime(-1), state(NEW) {}
 
 Process::Process(int id, int arrival, int burst, int prio, const std::string& name) 
     : processID(id), processName(name.empty() ? "P" + std::to_string(id) : name),
-      arrivalTime(arrival), burstTime(burst), remainingTime(burst), priority(prio), 
-      startTime(-1), completionTime(-1), waitingTime(0), turnaroundTime(0), 
+      arrivalTime(arrival), burstTime(burst), remainingTime(burst), workCredit(0.0), priority(prio),
+      width(1), startTime(-1), completionTime(-1), waitingTime(0), turnaroundTime(0),
       responseTime(-1), state(NEW) {}
 
 Process::Process(const Process& other) 
     : processID(other.processID), processName(other.processName),
       arrivalTime(other.arrivalTime), burstTime(other.burstTime),
-      remainingTime(other.remainingTime), priority(other.priority),
-      startTime(other.startTime), completionTime(other.completionTime),
-      waitingTime(other.waitingTime), turnaroundTime(other.turnaroundTime),
-      responseTime(other.responseTime), state(other.state),
-      executionHistory(other.executionHistory) {}
+      remainingTime(other.remainingTime), workCredit(other.workCredit), priority(other.priority),
+      width(other.width), group(other.group), startTime(other.startTime),
+      completionTime(other.completionTime), waitingTime(other.waitingTime),
+      turnaroundTime(other.turnaroundTime), responseTime(other.responseTime), state(other.state),
+      executionHistory(other.executionHistory), followerHistory(other.followerHistory) {}
 
 Process& Process::operator=(const Process& other) {
     if (this != &other) {
@@ -30,7 +32,10 @@ Process& Process::operator=(const Process& other) {
         arrivalTime = other.arrivalTime;
         burstTime = other.burstTime;
         remainingTime = other.remainingTime;
+        workCredit = other.workCredit;
         priority = other.priority;
+        width = other.width;
+        group = other.group;
         startTime = other.startTime;
         completionTime = other.completionTime;
         waitingTime = other.waitingTime;
@@ -38,6 +43,7 @@ Process& Process::operator=(const Process& other) {
         responseTime = other.responseTime;
         state = other.state;
         executionHistory = other.executionHistory;
+        followerHistory = other.followerHistory;
     }
     return *this;
 }
@@ -55,19 +61,26 @@ void Process::setCompletionTime(int time) {
 }
 
 void Process::executeFor(int time, int currentTime) {
+    executeFor(time, currentTime, time);
+}
+
+// Occupies CPU `cpu` for `time` units while retiring `work` units of the
+// burst; the two differ on cores faster or slower than the reference speed
+void Process::executeFor(int time, int currentTime, int work, int cpu) {
     if (startTime == -1) {
         setStartTime(currentTime);
     }
     
-    // Record execution in history
-    if (!executionHistory.empty() && 
-        executionHistory.back().first + executionHistory.back().second == currentTime) {
-        executionHistory.back().second += time;
+    // Record execution in history; a slice continues while the process stays
+    // on the same CPU
+    if (!executionHistory.empty() && executionHistory.back().end() == currentTime &&
+        executionHistory.back().cpu == cpu) {
+        executionHistory.back().duration += time;
     } else {
-        executionHistory.push_back({currentTime, time});
+        executionHistory.push_back({currentTime, time, cpu});
     }
     
-    remainingTime = std::max(0, remainingTime - time);
+    remainingTime = std::max(0, remainingTime - work);
     
     if (remainingTime <= 0) {
         state = TERMINATED;
@@ -75,22 +88,98 @@ void Process::executeFor(int time, int currentTime) {
     }
 }
 
+// Records a follower CPU held while the lead CPU runs the job; it retires no
+// work and does not count as service. A job holds several followers at once,
+// so the slice to extend is searched among those still open at this time.
+void Process::holdFor(int time, int currentTime, int cpu) {
+    for (auto slice = followerHistory.rbegin(); slice != followerHistory.rend() &&
+                                                slice->end() >= currentTime; ++slice) {
+        if (slice->cpu == cpu && slice->end() == currentTime) {
+            slice->duration += time;
+            return;
+        }
+    }
+    followerHistory.push_back({currentTime, time, cpu});
+}
+
 void Process::calculateMetrics() {
     if (completionTime != -1) {
         turnaroundTime = completionTime - arrivalTime;
-        waitingTime = turnaroundTime - burstTime;
+        waitingTime = turnaroundTime - getServiceTime();
         if (responseTime == -1 && startTime != -1) {
             responseTime = startTime - arrivalTime;
         }
     }
 }
 
+int Process::getServiceTime() const {
+    int total = 0;
+    for (const auto& execution : executionHistory) {
+        total += execution.duration;
+    }
+    return total;
+}
+
 void Process::reset() {
     remainingTime = burstTime;
+    workCredit = 0.0;
     state = NEW;
     startTime = completionTime = -1;
     waitingTime = turnaroundTime = responseTime = -1;
     executionHistory.clear();
+    followerHistory.clear();
+}
+
+static void saveSlices(CheckpointWriter& writer, const std::vector<ExecutionSlice>& slices) {
+    writer.writeInt(static_cast<long long>(slices.size()));
+    for (const auto& slice : slices) {
+        writer.writeInt(slice.start);
+        writer.writeInt(slice.duration);
+        writer.writeInt(slice.cpu);
+    }
+}
+
+static void restoreSlices(CheckpointReader& reader, std::vector<ExecutionSlice>& slices) {
+    long long count = reader.readInt();
+    if (count < 0) {
+        throw std::runtime_error("Checkpoint is corrupt");
+    }
+    slices.clear();
+    for (long long i = 0; i < count; ++i) {
+        ExecutionSlice slice;
+        slice.start = reader.readInt32();
+        slice.duration = reader.readInt32();
+        slice.cpu = reader.readInt32();
+        slices.push_back(slice);
+    }
+}
+
+void Process::saveState(CheckpointWriter& writer) const {
+    writer.writeInt(remainingTime);
+    writer.writeDouble(workCredit);
+    writer.writeInt(priority);
+    writer.writeInt(startTime);
+    writer.writeInt(completionTime);
+    writer.writeInt(waitingTime);
+    writer.writeInt(turnaroundTime);
+    writer.writeInt(responseTime);
+    writer.writeInt(state);
+    saveSlices(writer, executionHistory);
+    saveSlices(writer, followerHistory);
+}
+
+void Process::restoreState(CheckpointReader& reader) {
+    remainingTime = reader.readInt32();
+    workCredit = reader.readDouble();
+    priority = reader.readInt32();
+    startTime = reader.readInt32();
+    completionTime = reader.readInt32();
+    waitingTime = reader.readInt32();
+    turnaroundTime = reader.readInt32();
+    responseTime = reader.readInt32();
+    state = static_cast<ProcessState>(reader.readInt32());
+    restoreSlices(reader, executionHistory);
+    restoreSlices(reader, followerHistory);
 }
 
 void Process::display() const {
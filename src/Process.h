@@ -13,6 +13,18 @@ enum ProcessState {
     TERMINATED
 };
 
+class CheckpointWriter;
+class CheckpointReader;
+
+// A stretch of time a process held a CPU
+struct ExecutionSlice {
+    int start;
+    int duration;
+    int cpu;            // -1 when not recorded
+    
+    int end() const { return start + duration; }
+};
+
 class Process {
 private:
     int processID;
@@ -20,14 +32,18 @@ private:
     int arrivalTime;
     int burstTime;
     int remainingTime;
+    double workCredit;      // fraction of a burst unit retired on slow cores, kept across dispatches
     int priority;
+    int width;
+    std::string group;      // hierarchical group path, e.g. "/web/frontend"; empty for none
     int startTime;
     int completionTime;
     int waitingTime;
     int turnaroundTime;
     int responseTime;
     ProcessState state;
-    std::vector<std::pair<int, int>> executionHistory;
+    std::vector<ExecutionSlice> executionHistory;
+    std::vector<ExecutionSlice> followerHistory;    // CPUs a parallel job held besides its lead CPU
 
 public:
     // Constructors
@@ -38,32 +54,46 @@ public:
     
     // Getters
     int getProcessID() const { return processID; }
-    std::string getProcessName() const { return processName; }
+    const std::string& getProcessName() const { return processName; }
     int getArrivalTime() const { return arrivalTime; }
     int getBurstTime() const { return burstTime; }
     int getRemainingTime() const { return remainingTime; }
+    double getWorkCredit() const { return workCredit; }
     int getPriority() const { return priority; }
+    int getWidth() const { return width; }
+    const std::string& getGroup() const { return group; }
     int getStartTime() const { return startTime; }
     int getCompletionTime() const { return completionTime; }
     int getWaitingTime() const { return waitingTime; }
     int getTurnaroundTime() const { return turnaroundTime; }
     int getResponseTime() const { return responseTime; }
     ProcessState getState() const { return state; }
-    const std::vector<std::pair<int, int>>& getExecutionHistory() const { return executionHistory; }
+    const std::vector<ExecutionSlice>& getExecutionHistory() const { return executionHistory; }
+    const std::vector<ExecutionSlice>& getFollowerHistory() const { return followerHistory; }
     
     // Setters
     void setStartTime(int time);
     void setCompletionTime(int time);
     void setState(ProcessState newState) { state = newState; }
     void setRemainingTime(int time) { remainingTime = time; }
+    void setWorkCredit(double credit) { workCredit = credit; }
     void setPriority(int prio) { priority = prio; }
+    void setWidth(int cpusNeeded) { width = cpusNeeded < 1 ? 1 : cpusNeeded; }
+    void setGroup(const std::string& path) { group = path; }
     
     // Utility methods
     void executeFor(int time, int currentTime);
+    void executeFor(int time, int currentTime, int work, int cpu = -1);
+    void holdFor(int time, int currentTime, int cpu);     // follower CPU of a parallel job
     void calculateMetrics();
     bool isCompleted() const { return remainingTime <= 0; }
+    int getServiceTime() const;
     void reset();
     
+    // Run state only; the definition (ID, arrival, burst, width, group) is the workload's
+    void saveState(CheckpointWriter& writer) const;
+    void restoreState(CheckpointReader& reader);
+    
     // Display
     void display() const;
     std::string toString() const;
@@ -1,11 +1,29 @@
 #include "Scheduler.h"
+#include "utils/ArrivalStream.h"
+#include "core/SchedulingEngine.h"
+#include "core/AnalyticSolver.h"
+#include "core/TimeSeriesSampler.h"
+#include "core/TraceIndex.h"
+#include "core/Checkpoint.h"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
+#include <stdexcept>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <thread>
+#include <unordered_map>
+
+static const char CHECKPOINT_MAGIC[] = "SCHEDCKP";
+static const int CHECKPOINT_VERSION = 5;
 
 Scheduler::Scheduler(int numCPUs, const std::string& name) 
     : currentTime(0), timeQuantum(4), algorithm(FCFS_ALG), 
-      algorithmName(name), preemptive(false), verbose(false) {
+      algorithmName(name), preemptive(false), verbose(false), placement(PLACE_BY_INDEX),
+      retirementSink(nullptr), sampler(nullptr), solverMode(SOLVE_AUTO), quiet(false), runInProgress(false),
+      arrivalCursor(0), arrivalCursorActive(false), completedCount(0), loopAllocations(0) {
     
     for (int i = 0; i < numCPUs; ++i) {
         cpus.push_back(std::make_unique<CPU>(i));
@@ -15,7 +33,6 @@ Scheduler::Scheduler(int numCPUs, const std::string& name)
 void Scheduler::addProcess(std::shared_ptr<Process> process) {
     if (process) {
         processes.push_back(process);
-        allProcesses.push_back(std::make_shared<Process>(*process));
     }
 }
 
@@ -25,46 +42,364 @@ void Scheduler::addProcesses(const std::vector<std::shared_ptr<Process>>& procs)
     }
 }
 
+void Scheduler::setWorkload(std::shared_ptr<const Workload> shared) {
+    workload = std::move(shared);
+    arena = std::make_shared<std::vector<Process>>();
+    reset();
+}
+
 void Scheduler::run() {
-    std::cout << "\n=== Running " << algorithmName << " ===" << std::endl;
+    if (!quiet) {
+        std::cout << "\n=== Running " << algorithmName << " ===" << std::endl;
+        std::cout << "Number of CPUs: " << cpus.size() << std::endl;
+        if (preemptive && (algorithm == RR_ALG || algorithm == GROUP_ALG)) {
+            std::cout << "Time Quantum: " << timeQuantum << std::endl;
+        }
+        std::cout << "Total Processes: " << processes.size() << std::endl;
+        std::cout << std::string(50, '-') << std::endl;
+    }
+    
+    runInProgress = false;
+    startProfile();
+    startObserving();
+    schedule();
+    
+    // Verbose, sampled and observed runs are for watching the tick loop, so
+    // they always simulate
+    std::string outcome = "Simulation completed";
+    std::string reason;
+    bool watched = verbose || sampler || !observers.empty();
+    if (solverMode == SOLVE_SIMULATE || watched || !AnalyticSolver::supports(*this, &reason)) {
+        if (solverMode == SOLVE_VALIDATE && !quiet) {
+            std::cout << "Closed form not applicable: " << (watched ? "watched run" : reason) << std::endl;
+        }
+        runLoop(std::numeric_limits<int>::max());
+    } else {
+        AnalyticSchedule solved = AnalyticSolver::solve(*this);
+        if (solverMode == SOLVE_VALIDATE) {
+            runLoop(std::numeric_limits<int>::max());
+            int mismatches = AnalyticSolver::compare(*this, solved);
+            if (mismatches == 0) {
+                std::cout << "Closed form matches the simulation" << std::endl;
+            } else {
+                std::cout << "Closed form differs from the simulation in " << mismatches << " values" << std::endl;
+            }
+        } else {
+            AnalyticSolver::apply(*this, solved);
+            outcome = "Solved in closed form, completed";
+        }
+    }
+    
+    finishRun();
+    
+    if (!quiet) {
+        std::cout << outcome << " at time " << currentTime << std::endl;
+        if (PROFILING_ENABLED && profile.ticks > 0) {
+            Profiler::print(profile);
+        }
+    }
+}
+
+// Consumes arrivals from the stream as simulated time reaches them and retires
+// finished processes into the running totals, so memory follows the live set.
+// With tickMillis > 0 each simulated time unit is paced to that much wall time.
+void Scheduler::runStreaming(ArrivalStream& stream, int tickMillis) {
+    std::cout << "\n=== Streaming " << algorithmName << " ===" << std::endl;
     std::cout << "Number of CPUs: " << cpus.size() << std::endl;
-    if (preemptive && algorithm == RR_ALG) {
+    if (preemptive && (algorithm == RR_ALG || algorithm == GROUP_ALG)) {
         std::cout << "Time Quantum: " << timeQuantum << std::endl;
     }
-    std::cout << "Total Processes: " << processes.size() << std::endl;
     std::cout << std::string(50, '-') << std::endl;
     
+    startProfile();
+    startObserving();
     schedule();
     
-    while (!areAllProcessesCompleted()) {
-        if (verbose && currentTime % 5 == 0) {
-            std::cout << "\n--- Time " << currentTime << " ---" << std::endl;
+    auto wallStart = std::chrono::steady_clock::now();
+    auto pending = stream.next();
+    
+    while (pending || !areAllProcessesCompleted()) {
+        while (pending && pending->getArrivalTime() <= currentTime) {
+            processes.push_back(pending);
+            pending = stream.next();
         }
         
-        updateReadyQueue();
-        assignProcessesToCPUs();
+        step();
+        retireCompletedProcesses();
         
-        for (size_t i = 0; i < cpus.size(); ++i) {
-            cpus[i]->tick(currentTime);
-            if (preemptive) {
-                preempt(static_cast<int>(i));
-            }
+        if (tickMillis > 0) {
+            std::this_thread::sleep_until(wallStart + std::chrono::milliseconds(
+                static_cast<long long>(tickMillis) * currentTime));
         }
-        
-        if (verbose && currentTime % 5 == 0) {
-            displayCurrentState();
+    }
+    
+    std::cout << "Simulation completed at time " << currentTime
+              << " (" << retired.count << " processes retired)" << std::endl;
+    
+    finishRun();
+    if (PROFILING_ENABLED) {
+        Profiler::print(profile);
+    }
+}
+
+// Generic loop through virtual calls; concrete policies override these with
+// SchedulingEngine instantiations specialised for their own type
+void Scheduler::runLoop(int stopTime) {
+    SchedulingEngine<Scheduler>::run(*this, stopTime);
+}
+
+void Scheduler::step() {
+    SchedulingEngine<Scheduler>::step(*this);
+}
+
+void Scheduler::retireCompletedProcesses() {
+    auto firstRetired = std::stable_partition(processes.begin(), processes.end(),
+        [](const std::shared_ptr<Process>& p) { return p->getState() != TERMINATED; });
+    
+    for (auto it = firstRetired; it != processes.end(); ++it) {
+        retired.count++;
+        retired.totalWaitingTime += (*it)->getWaitingTime();
+        retired.totalTurnaroundTime += (*it)->getTurnaroundTime();
+        retired.totalResponseTime += (*it)->getResponseTime();
+        if (retirementSink) {
+            retirementSink->onRetired(**it);
         }
-        
-        advanceTime();
+    }
+    processes.erase(firstRetired, processes.end());
+}
+
+long long Scheduler::getProcessCount() const {
+    return retired.count + static_cast<long long>(processes.size());
+}
+
+// Dispatches and preemptions are the CPUs' counts at the end of the run less
+// those at the start
+void Scheduler::startProfile() {
+    if (!PROFILING_ENABLED) return;
+    profile = RunProfile();
+    for (const auto& cpu : cpus) {
+        profile.dispatches -= cpu->getDispatchCount();
+        profile.preemptions -= cpu->getPreemptionCount();
+    }
+}
+
+void Scheduler::finishProfile() {
+    if (!PROFILING_ENABLED) return;
+    for (const auto& cpu : cpus) {
+        profile.dispatches += cpu->getDispatchCount();
+        profile.preemptions += cpu->getPreemptionCount();
+    }
+}
+
+// A run from time 0 (a first run or one after reset()) starts the sampler's
+// series afresh; resumed runs keep adding to it
+void Scheduler::startObserving() {
+    if (sampler && currentTime == 0) {
+        sampler->clear();
+    }
+    if (observers.empty()) return;
+    observedOccupants.assign(cpus.size(), nullptr);
+    for (size_t i = 0; i < cpus.size(); ++i) {
+        observedOccupants[i] = cpus[i]->getOccupant();
+    }
+    for (auto* observer : observers) {
+        observer->onRunStart(*this);
+    }
+}
+
+// Profile totals, the sampler's open buckets and observers' end of run
+void Scheduler::finishRun() {
+    finishProfile();
+    if (sampler) {
+        sampler->flush();
+    }
+    for (auto* observer : observers) {
+        observer->onRunEnd(currentTime);
+    }
+}
+
+bool Scheduler::runUntil(int stopTime) {
+    if (!runInProgress) {
+        startProfile();
+        startObserving();
+        schedule();
+        runInProgress = true;
+    }
+    runLoop(stopTime);
+    if (completedCount < processes.size()) return false;
+    
+    runInProgress = false;
+    finishRun();
+    return true;
+}
+
+// Header: format, the setup a restore must match and each process's
+// definition in the current `processes` order. Then the run state.
+std::string Scheduler::checkpoint() const {
+    if (retired.count > 0) {
+        throw std::logic_error("Streaming runs cannot be checkpointed");
+    }
+    CheckpointWriter writer(processes);
+    writer.writeString(CHECKPOINT_MAGIC);
+    writer.writeInt(CHECKPOINT_VERSION);
+    writer.writeString(algorithmName);
+    writer.writeInt(static_cast<long long>(cpus.size()));
+    writer.writeInt(timeQuantum);
+    writer.writeInt(static_cast<long long>(processes.size()));
+    for (const auto& process : processes) {
+        writer.writeInt(process->getProcessID());
+        writer.writeInt(process->getArrivalTime());
+        writer.writeInt(process->getBurstTime());
+        writer.writeInt(process->getPriority());
+        writer.writeInt(process->getWidth());
+        writer.writeString(process->getGroup());
+    }
+    
+    writer.writeBool(runInProgress);
+    writer.writeInt(currentTime);
+    for (const auto& process : processes) {
+        process->saveState(writer);
+    }
+    for (const auto& cpu : cpus) {
+        cpu->saveState(writer);
+    }
+    writer.writeProcesses(readyQueue);
+    writer.writeInt(retired.count);
+    writer.writeDouble(retired.totalWaitingTime);
+    writer.writeDouble(retired.totalTurnaroundTime);
+    writer.writeDouble(retired.totalResponseTime);
+    savePolicyState(writer);
+    return writer.data();
+}
+
+void Scheduler::restore(const std::string& data, bool acceptLaterEdits) {
+    CheckpointReader reader(data);
+    if (reader.readString() != CHECKPOINT_MAGIC || reader.readInt() != CHECKPOINT_VERSION) {
+        throw std::runtime_error("Not a checkpoint of this simulator version");
+    }
+    if (reader.readString() != algorithmName || reader.readInt() != static_cast<long long>(cpus.size()) ||
+        reader.readInt() != timeQuantum) {
+        throw std::invalid_argument("Checkpoint was taken with a different policy, CPU count or quantum");
+    }
+    long long savedCount = reader.readInt();
+    if (savedCount < 0 || (!acceptLaterEdits && savedCount != static_cast<long long>(processes.size()))) {
+        throw std::invalid_argument("Checkpoint was taken on a different workload");
+    }
+    std::vector<Process> saved;
+    for (long long i = 0; i < savedCount; ++i) {
+        int id = reader.readInt32();
+        int arrival = reader.readInt32();
+        int burst = reader.readInt32();
+        int priority = reader.readInt32();
+        saved.emplace_back(id, arrival, burst, priority);
+        saved.back().setWidth(reader.readInt32());
+        saved.back().setGroup(reader.readString());
+    }
+    bool savedInProgress = reader.readBool();
+    int savedTime = reader.readInt32();
+    
+    // A started run has the policy's process order, which schedule() rebuilds
+    // from the workload. Saved processes are then matched by ID, equal IDs in
+    // turn.
+    reset();
+    if (savedInProgress) {
+        schedule();
+    }
+    std::unordered_map<int, std::vector<size_t>> byID;
+    for (size_t i = processes.size(); i-- > 0;) {
+        byID[processes[i]->getProcessID()].push_back(i);
+    }
+    std::vector<bool> matched(processes.size(), false);
+    std::vector<std::shared_ptr<Process>> savedOrder;
+    std::vector<bool> edited;
+    for (const Process& definition : saved) {
+        std::shared_ptr<Process> process;
+        auto match = byID.find(definition.getProcessID());
+        if (match != byID.end() && !match->second.empty()) {
+            matched[match->second.back()] = true;
+            process = processes[match->second.back()];
+            match->second.pop_back();
+        }
+        bool same = process && process->getArrivalTime() == definition.getArrivalTime() &&
+                    process->getBurstTime() == definition.getBurstTime() &&
+                    process->getPriority() == definition.getPriority() &&
+                    process->getWidth() == definition.getWidth() &&
+                    process->getGroup() == definition.getGroup();
+        if (!same && !acceptLaterEdits) {
+            throw std::invalid_argument("Checkpoint was taken on a different workload");
+        }
+        savedOrder.push_back(process);
+        edited.push_back(!same);
+    }
+    
+    // Edits are only consistent with the saved prefix if neither version of
+    // the process had arrived by then
+    for (size_t i = 0; i < processes.size(); ++i) {
+        if (!matched[i] && processes[i]->getArrivalTime() < savedTime) {
+            throw std::invalid_argument("Workload edit to " + processes[i]->getProcessName() +
+                                        " precedes the checkpoint");
+        }
+    }
+    for (size_t i = 0; i < saved.size(); ++i) {
+        if (edited[i] && (saved[i].getArrivalTime() < savedTime ||
+                          (savedOrder[i] && savedOrder[i]->getArrivalTime() < savedTime))) {
+            throw std::invalid_argument("Workload edit to process " + std::to_string(saved[i].getProcessID()) +
+                                        " precedes the checkpoint");
+        }
+    }
+    reader.setProcesses(savedOrder);
+    
+    // Edited processes keep the state reset() gave them
+    runInProgress = savedInProgress;
+    currentTime = savedTime;
+    Process discarded;
+    for (size_t i = 0; i < savedOrder.size(); ++i) {
+        (edited[i] ? discarded : *savedOrder[i]).restoreState(reader);
+    }
+    for (auto& cpu : cpus) {
+        cpu->restoreState(reader);
+    }
+    for (const auto& process : reader.readProcesses()) {
+        readyQueue.push(process);
+    }
+    retired.count = reader.readInt();
+    retired.totalWaitingTime = reader.readDouble();
+    retired.totalTurnaroundTime = reader.readDouble();
+    retired.totalResponseTime = reader.readDouble();
+    restorePolicyState(reader);
+    if (!reader.atEnd()) {
+        throw std::runtime_error("Checkpoint has trailing data");
     }
     
-    std::cout << "Simulation completed at time " << currentTime << std::endl;
+    if (runInProgress) {
+        startProfile();
+        startObserving();
+    }
+}
+
+void Scheduler::saveCheckpoint(const std::string& filename) const {
+    std::string data = checkpoint();
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open file " + filename);
+    }
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    if (!file) {
+        throw std::runtime_error("Could not write file " + filename);
+    }
+}
+
+void Scheduler::restoreCheckpoint(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open file " + filename);
+    }
+    restore(std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()));
 }
 
 void Scheduler::updateReadyQueue() {
-    auto arrivedProcesses = getArrivedProcesses();
-    for (auto& process : arrivedProcesses) {
-        if (process->getState() == NEW) {
+    for (const auto& process : processes) {
+        if (process->getArrivalTime() <= currentTime && process->getState() == NEW) {
             process->setState(READY);
             readyQueue.push(process);
             onProcessArrival(process);
@@ -83,27 +418,150 @@ void Scheduler::advanceTime() {
     currentTime++;
 }
 
-std::vector<std::shared_ptr<Process>> Scheduler::getArrivedProcesses() const {
-    std::vector<std::shared_ptr<Process>> arrived;
-    for (const auto& process : processes) {
-        if (process->getArrivalTime() <= currentTime && process->getState() == NEW) {
-            arrived.push_back(process);
-        }
+// Sizes every queue for the whole workload and orders the arrivals, so the
+// loop that follows admits each process once instead of scanning all of them
+// every tick. Processes that arrived before now are admitted together at the
+// first tick in their `processes` order, exactly as a scan would. Storage is
+// reused between runs, so on a rerun this allocates nothing.
+void Scheduler::beginRun() {
+    const size_t count = processes.size();
+    readyQueue.reserve(count);
+    prepareRun(count);
+    
+    arrivalOrder.resize(count);
+    completedCount = 0;
+    for (size_t i = 0; i < count; ++i) {
+        arrivalOrder[i] = i;
+        completedCount += processes[i]->getState() == TERMINATED;
     }
-    return arrived;
+    std::sort(arrivalOrder.begin(), arrivalOrder.end(), [this](size_t a, size_t b) {
+        int arrivalA = std::max(processes[a]->getArrivalTime(), currentTime);
+        int arrivalB = std::max(processes[b]->getArrivalTime(), currentTime);
+        return arrivalA != arrivalB ? arrivalA < arrivalB : a < b;
+    });
+    arrivalCursor = 0;
+    arrivalCursorActive = true;
 }
 
 void Scheduler::assignProcessesToCPUs() {
+    if (placement == PLACE_BY_INDEX) {
+        for (auto& cpu : cpus) {
+            if (cpu->getIsIdle()) {
+                std::shared_ptr<Process> nextProcess;
+                {
+                    ScopedPhase timer(profile, PHASE_SELECT);
+                    nextProcess = selectNextProcess();
+                }
+                if (nextProcess) {
+                    cpu->assignProcess(nextProcess);
+                }
+            }
+        }
+        return;
+    }
+    
+    idleCPUs.clear();
     for (auto& cpu : cpus) {
         if (cpu->getIsIdle()) {
-            auto nextProcess = selectNextProcess();
-            if (nextProcess) {
-                cpu->assignProcess(nextProcess);
+            idleCPUs.push_back(cpu.get());
+        }
+    }
+    if (idleCPUs.empty()) return;
+    
+    std::stable_sort(idleCPUs.begin(), idleCPUs.end(), [](const CPU* a, const CPU* b) {
+        return a->getEffectiveSpeed() > b->getEffectiveSpeed();
+    });
+    
+    // Let the policy pick as many processes as there are idle cores, then
+    // hand the most deserving of that batch to the fastest core
+    placementBatch.clear();
+    for (size_t i = 0; i < idleCPUs.size(); ++i) {
+        ScopedPhase timer(profile, PHASE_SELECT);
+        auto nextProcess = selectNextProcess();
+        if (!nextProcess) break;
+        placementBatch.push_back(nextProcess);
+    }
+    
+    if (placement == PLACE_SHORTEST_ON_FASTEST) {
+        std::stable_sort(placementBatch.begin(), placementBatch.end(),
+                         [](const std::shared_ptr<Process>& a, const std::shared_ptr<Process>& b) {
+                             return a->getRemainingTime() < b->getRemainingTime();
+                         });
+    } else if (placement == PLACE_PRIORITY_ON_FASTEST) {
+        std::stable_sort(placementBatch.begin(), placementBatch.end(),
+                         [](const std::shared_ptr<Process>& a, const std::shared_ptr<Process>& b) {
+                             return a->getPriority() < b->getPriority();
+                         });
+    }
+    
+    for (size_t i = 0; i < placementBatch.size(); ++i) {
+        idleCPUs[i]->assignProcess(placementBatch[i]);
+    }
+    placementBatch.clear();
+}
+
+void Scheduler::setSampler(TimeSeriesSampler* timeSeries) {
+    if (timeSeries && timeSeries->getCPUCount() != static_cast<int>(cpus.size())) {
+        throw std::invalid_argument("Sampler covers a different number of CPUs than the scheduler");
+    }
+    sampler = timeSeries;
+}
+
+void Scheduler::addObserver(ScheduleObserver* observer) {
+    if (!observer) return;
+    if (runInProgress) {
+        // Joining a run that runUntil() paused: the observer starts at the
+        // current time and sees whatever already holds a CPU as dispatched now
+        if (observers.empty()) {
+            observedOccupants.assign(cpus.size(), nullptr);
+            for (size_t i = 0; i < cpus.size(); ++i) {
+                observedOccupants[i] = cpus[i]->getOccupant();
             }
         }
+        observer->onRunStart(*this);
+        for (size_t i = 0; i < observedOccupants.size(); ++i) {
+            if (observedOccupants[i]) {
+                observer->onDispatch(currentTime, static_cast<int>(i), *observedOccupants[i]);
+            }
+        }
+    }
+    observers.push_back(observer);
+}
+
+void Scheduler::removeObserver(ScheduleObserver* observer) {
+    observers.erase(std::remove(observers.begin(), observers.end(), observer), observers.end());
+}
+
+void Scheduler::setCPUSpeeds(const std::vector<double>& speeds) {
+    if (speeds.size() != cpus.size()) {
+        throw std::invalid_argument("Expected one speed factor per CPU");
+    }
+    for (size_t i = 0; i < cpus.size(); ++i) {
+        cpus[i]->setSpeedFactor(speeds[i]);
     }
 }
 
+void Scheduler::setCPUFrequencyLevels(const std::vector<double>& levels, int transitionLatency,
+                                      bool downclockWhenIdle) {
+    for (auto& cpu : cpus) {
+        cpu->setFrequencyLevels(levels, transitionLatency);
+        cpu->setIdleDownclock(downclockWhenIdle);
+    }
+}
+
+std::string Scheduler::describeSetup() const {
+    std::string setup = algorithmName + "; quantum " + std::to_string(timeQuantum) +
+                        "; placement " + std::to_string(placement);
+    for (const auto& cpu : cpus) {
+        setup += "; cpu " + cpu->describeSetup();
+    }
+    std::string policy = describePolicy();
+    if (!policy.empty()) {
+        setup += "; " + policy;
+    }
+    return setup;
+}
+
 void Scheduler::displayCurrentState() const {
     for (const auto& cpu : cpus) {
         std::cout << "  ";
@@ -114,18 +572,34 @@ void Scheduler::displayCurrentState() const {
 
 void Scheduler::reset() {
     currentTime = 0;
+    runInProgress = false;
     
-    while (!readyQueue.empty()) {
-        readyQueue.pop();
-    }
+    readyQueue.clear();
+    arrivalCursorActive = false;
     
     for (auto& cpu : cpus) {
         cpu->reset();
     }
+    resetPolicy();
+    retired = RetiredTotals();
+    profile = RunProfile();
     
+    if (!workload) {
+        for (auto& process : processes) {
+            process->reset();
+        }
+        return;
+    }
+    
+    // Copy-assigning over the existing slots reuses their storage, so after
+    // the first run a reset allocates nothing. The handles share the arena's
+    // single control block instead of owning one per process.
+    const std::vector<Process>& definitions = workload->getProcesses();
+    arena->assign(definitions.begin(), definitions.end());
     processes.clear();
-    for (const auto& original : allProcesses) {
-        processes.push_back(std::make_shared<Process>(*original));
+    processes.reserve(arena->size());
+    for (auto& slot : *arena) {
+        processes.push_back(std::shared_ptr<Process>(arena, &slot));
     }
 }
 
@@ -151,26 +625,28 @@ void Scheduler::printGanttChart() const {
         }
     }
     
-    for (size_t cpuID = 0; cpuID < cpus.size(); ++cpuID) {
-        std::cout << "CPU " << cpuID << ": ";
+    // Each CPU's row is filled from its own spans; labels are cut once per
+    // process and slots point at them
+    TraceIndex index(processes, static_cast<int>(cpus.size()));
+    static const std::string idle = "--";
+    std::unordered_map<const Process*, std::string> labels;
+    std::vector<const std::string*> timeline(maxTime);
         
-        std::vector<std::string> timeline(maxTime, "--");
-        
-        for (const auto& process : processes) {
-            for (const auto& execution : process->getExecutionHistory()) {
-                int startTime = execution.first;
-                int duration = execution.second;
-                
-                for (int t = startTime; t < startTime + duration && t < maxTime; ++t) {
-                    if (timeline[t] == "--") {
-                        timeline[t] = process->getProcessName().substr(0, 2);
-                    }
-                }
+    for (size_t cpuID = 0; cpuID < cpus.size(); ++cpuID) {
+        std::fill(timeline.begin(), timeline.end(), &idle);
+        for (const TraceSpan& span : index.overlapping(static_cast<int>(cpuID), 0, maxTime)) {
+            auto label = labels.find(span.process);
+            if (label == labels.end()) {
+                label = labels.emplace(span.process, span.process->getProcessName().substr(0, 2)).first;
+            }
+            for (int t = std::max(0, span.start); t < span.end && t < maxTime; ++t) {
+                timeline[t] = &label->second;
             }
         }
         
-        for (const auto& slot : timeline) {
-            std::cout << "|" << slot;
+        std::cout << "CPU " << cpuID << ": ";
+        for (const std::string* slot : timeline) {
+            std::cout << "|" << *slot;
         }
         std::cout << "|" << std::endl;
     }
@@ -198,33 +674,33 @@ void Scheduler::printStatistics() const {
 }
 
 double Scheduler::calculateAverageWaitingTime() const {
-    if (processes.empty()) return 0.0;
+    if (getProcessCount() == 0) return 0.0;
     
-    double total = 0.0;
+    double total = retired.totalWaitingTime;
     for (const auto& process : processes) {
         total += process->getWaitingTime();
     }
-    return total / processes.size();
+    return total / getProcessCount();
 }
 
 double Scheduler::calculateAverageTurnaroundTime() const {
-    if (processes.empty()) return 0.0;
+    if (getProcessCount() == 0) return 0.0;
     
-    double total = 0.0;
+    double total = retired.totalTurnaroundTime;
     for (const auto& process : processes) {
         total += process->getTurnaroundTime();
     }
-    return total / processes.size();
+    return total / getProcessCount();
 }
 
 double Scheduler::calculateAverageResponseTime() const {
-    if (processes.empty()) return 0.0;
+    if (getProcessCount() == 0) return 0.0;
     
-    double total = 0.0;
+    double total = retired.totalResponseTime;
     for (const auto& process : processes) {
         total += process->getResponseTime();
     }
-    return total / processes.size();
+    return total / getProcessCount();
 }
 
 double Scheduler::calculateAverageCPUUtilization() const {
@@ -237,6 +713,14 @@ double Scheduler::calculateAverageCPUUtilization() const {
     return totalUtilization / cpus.size();
 }
 
+long long Scheduler::countContextSwitches() const {
+    long long total = 0;
+    for (const auto& cpu : cpus) {
+        total += cpu->getDispatchCount();
+    }
+    return total;
+}
+
 double Scheduler::calculateThroughput() const {
-    return currentTime > 0 ? (double)processes.size() / currentTime : 0.0;
+    return currentTime > 0 ? (double)getProcessCount() / currentTime : 0.0;
 }
\ No newline at end of file
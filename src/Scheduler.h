@@ -3,63 +3,231 @@
 
 #include "Process.h"
 #include "core/CPU.h"
+#include "core/Workload.h"
+#include "core/RunQueues.h"
+#include "core/Profiler.h"
 #include <vector>
 #include <memory>
-#include <queue>
 #include <string>
 
+class ArrivalStream;
+class TimeSeriesSampler;
+template <typename Policy> class SchedulingEngine;
+
 enum SchedulingAlgorithm {
     FCFS_ALG,
     SJF_ALG,
     SRTF_ALG,
     RR_ALG,
-    PRIORITY_ALG
+    PRIORITY_ALG,
+    GANG_ALG,
+    GROUP_ALG
+};
+
+// How idle cores are matched with the processes the policy selects
+enum CorePlacement {
+    PLACE_BY_INDEX,             // CPU 0 first, regardless of speed
+    PLACE_FASTEST_FIRST,        // fastest idle core gets the first selection
+    PLACE_SHORTEST_ON_FASTEST,  // shortest remaining work goes to the fastest core
+    PLACE_PRIORITY_ON_FASTEST   // highest priority goes to the fastest core
+};
+
+// Whether run() may replace the tick loop with a closed-form schedule
+enum SolverMode {
+    SOLVE_AUTO,         // closed form whenever AnalyticSolver supports the setup
+    SOLVE_SIMULATE,     // always run the tick loop
+    SOLVE_VALIDATE      // run both and report any difference
+};
+
+// Aggregates of processes that finished and were dropped from memory
+struct RetiredTotals {
+    long long count = 0;
+    double totalWaitingTime = 0.0;
+    double totalTurnaroundTime = 0.0;
+    double totalResponseTime = 0.0;
+};
+
+// Receives each finished process as a streaming run drops it from memory
+class RetirementSink {
+public:
+    virtual ~RetirementSink() = default;
+    virtual void onRetired(const Process& process) = 0;
+};
+
+class Scheduler;
+
+// Follows a run as it happens: arrivals, processes switched onto and off each
+// CPU, and once per tick how many processes wait and run. A process switched
+// off at the time it was switched on never ran.
+class ScheduleObserver {
+public:
+    virtual ~ScheduleObserver() = default;
+    virtual void onRunStart(const Scheduler& /* scheduler */) {}
+    virtual void onArrival(int /* time */, const Process& /* process */) {}
+    virtual void onDispatch(int /* time */, int /* cpuID */, const Process& /* process */) {}
+    virtual void onRelease(int /* time */, int /* cpuID */, const Process& /* process */, bool /* completed */) {}
+    virtual void onTick(int /* time */, size_t /* waiting */, size_t /* running */) {}
+    virtual void onRunEnd(int /* time */) {}
 };
 
 class Scheduler {
+    template <typename Policy> friend class SchedulingEngine;
+    friend class AnalyticSolver;
+    friend class FusedSimulation;
+    friend class PartitionedSimulation;
+    
 protected:
     std::vector<std::shared_ptr<Process>> processes;
-    std::vector<std::shared_ptr<Process>> allProcesses;
+    std::shared_ptr<const Workload> workload;
+    std::shared_ptr<std::vector<Process>> arena;   // run state of `workload`; `processes` alias into it
     std::vector<std::unique_ptr<CPU>> cpus;
-    std::queue<std::shared_ptr<Process>> readyQueue;
+    RingQueue<std::shared_ptr<Process>> readyQueue;
     int currentTime;
     int timeQuantum;
     SchedulingAlgorithm algorithm;
     std::string algorithmName;
     bool preemptive;
     bool verbose;
+    CorePlacement placement;
+    std::vector<CPU*> idleCPUs;
+    std::vector<std::shared_ptr<Process>> placementBatch;
+    RetiredTotals retired;
+    RetirementSink* retirementSink;
+    TimeSeriesSampler* sampler;
+    std::vector<ScheduleObserver*> observers;
+    std::vector<const Process*> observedOccupants;  // per CPU, as last reported to observers
+    SolverMode solverMode;
+    bool quiet;
+    bool runInProgress;     // runUntil() stopped, or restore() loaded, a run that has not finished
 
+    // Tick-loop bookkeeping set up by beginRun(): indices into `processes` by
+    // arrival, the next one to admit, and how many processes have finished
+    std::vector<size_t> arrivalOrder;
+    size_t arrivalCursor;
+    bool arrivalCursorActive;
+    size_t completedCount;
+    long long loopAllocations;
+    RunProfile profile;
+    
     // Helper methods
     void updateReadyQueue();
     bool areAllProcessesCompleted() const;
     void advanceTime();
-    std::vector<std::shared_ptr<Process>> getArrivedProcesses() const;
-    void assignProcessesToCPUs();
+    void beginRun();
+    virtual void assignProcessesToCPUs();
     void displayCurrentState() const;
+    virtual void runLoop(int stopTime);
+    virtual void step();
+    void retireCompletedProcesses();
+    long long getProcessCount() const;
+    void startProfile();
+    void finishProfile();
+    void startObserving();
+    void finishRun();
 
+    // Drops policy-owned queues so reset() can be called mid-run
+    virtual void resetPolicy() {}
+    
+    // Sizes policy-owned queues for a run over `processCount` processes
+    virtual void prepareRun(size_t /* processCount */) {}
+    
+    // Policy settings beyond name, CPUs and quantum that change results, for
+    // describeSetup(); empty when there are none
+    virtual std::string describePolicy() const { return ""; }
+    
+    // Policy-owned queues and counters, in an order restorePolicyState reads back
+    virtual void savePolicyState(CheckpointWriter& /* writer */) const {}
+    virtual void restorePolicyState(CheckpointReader& /* reader */) {}
+    
 public:
     Scheduler(int numCPUs = 1, const std::string& name = "Base Scheduler");
     virtual ~Scheduler() = default;
     
-    // Process management
+    // Process management. Added processes are shared with the caller and
+    // updated in place by a run.
     void addProcess(std::shared_ptr<Process> process);
     void addProcesses(const std::vector<std::shared_ptr<Process>>& procs);
     
+    // Runs an immutable workload instead: its processes are copied into an
+    // arena owned by this scheduler once, and reset() reinitialises the arena
+    // in bulk. getProcesses() hands out pointers into the arena that stay
+    // valid while any of them is held, until the next reset() or setWorkload().
+    void setWorkload(std::shared_ptr<const Workload> shared);
+    
     // Core scheduling methods
     virtual void schedule() = 0;
     virtual void preempt(int cpuID) {}
     virtual std::shared_ptr<Process> selectNextProcess() = 0;
     virtual void onProcessArrival(std::shared_ptr<Process> process) {}
     
+    // Processes waiting for a CPU, policy-owned queues included
+    virtual size_t getWaitingCount() const { return readyQueue.size(); }
+    
     // Simulation control
     void run();
+    void runStreaming(ArrivalStream& stream, int tickMillis = 0);
+    
+    // Simulates the ticks before stopTime and returns whether every process
+    // has finished. Later calls continue the same run, so a run can be
+    // stopped, checkpointed and carried on; it never uses the closed form.
+    bool runUntil(int stopTime);
+    
+    // Complete state of a run stopped by runUntil(): time, CPUs, queues in
+    // order, each process's progress and the statistics so far. restore()
+    // needs a scheduler with the same policy, CPU count, quantum and
+    // workload, and afterwards runUntil() continues exactly as the original
+    // run would have, so one prefix can fork several what-if branches.
+    // Samplers, observers and the profile are not part of a checkpoint;
+    // those attached before restore() follow the run from there on.
+    // With acceptLaterEdits the workload may differ in processes that arrive
+    // at or after the checkpoint's time, which are then edited, added or
+    // removed as if the run had had the new workload from the start.
+    std::string checkpoint() const;
+    void restore(const std::string& data, bool acceptLaterEdits = false);
+    void saveCheckpoint(const std::string& filename) const;
+    void restoreCheckpoint(const std::string& filename);
+    
+    // Back to time 0 with every process NEW, ready for another run()
     void reset();
     
     // Getters/Setters
     void setTimeQuantum(int quantum) { timeQuantum = quantum; }
     void setVerbose(bool v) { verbose = v; }
+    void setQuiet(bool q) { quiet = q; }  // no run banner, e.g. for batch evaluations
+    void setCPUSpeeds(const std::vector<double>& speeds);
+    void setCPUFrequencyLevels(const std::vector<double>& levels, int transitionLatency,
+                               bool downclockWhenIdle);
+    void setCorePlacement(CorePlacement p) { placement = p; }
+    void setRetirementSink(RetirementSink* sink) { retirementSink = sink; }
+    
+    // Feeds every tick of later runs to the sampler, which must cover as many
+    // CPUs; sampled runs always simulate, and each run from time 0 clears the
+    // sampler first. Null stops sampling.
+    void setSampler(TimeSeriesSampler* timeSeries);
+    
+    // Reports later runs to the observer as they simulate, after any observers
+    // added before it; observed runs always simulate. Added while runUntil()
+    // has paused a run, it joins that run at the current time.
+    void addObserver(ScheduleObserver* observer);
+    void removeObserver(ScheduleObserver* observer);
+    void setSolverMode(SolverMode mode) { solverMode = mode; }
     int getCurrentTime() const { return currentTime; }
     std::string getAlgorithmName() const { return algorithmName; }
+    const std::vector<std::shared_ptr<Process>>& getProcesses() const { return processes; }
+    int getNumCPUs() const { return static_cast<int>(cpus.size()); }
+    int getTimeQuantum() const { return timeQuantum; }
+    
+    // Everything besides the workload that decides a run's results, as one
+    // line of text: policy, CPUs with their speeds, quantum and placement
+    std::string describeSetup() const;
+    
+    // Heap allocations made by the last run()'s tick loop; always 0 unless
+    // built with -DSCHED_COUNT_ALLOCATIONS (see AllocationCounter)
+    long long getLoopAllocations() const { return loopAllocations; }
+    
+    // Phase times and event counts of the last run's tick loop; empty unless
+    // built with -DSCHED_ENABLE_PROFILING (see Profiler)
+    const RunProfile& getProfile() const { return profile; }
     
     // Statistics and output
     void printResults() const;
@@ -72,6 +240,7 @@ public:
     double calculateAverageResponseTime() const;
     double calculateAverageCPUUtilization() const;
     double calculateThroughput() const;
+    long long countContextSwitches() const;
 };
 
 #endif // SCHEDULER_H
\ No newline at end of file
@@ -1,7 +1,7 @@
 #include "FCFS.h"
 #include <algorithm>
 
-FCFS::FCFS(int numCPUs) : Scheduler(numCPUs, "First Come First Served (FCFS)") {
+FCFS::FCFS(int numCPUs) : PolicyScheduler<FCFS>(numCPUs, "First Come First Served (FCFS)") {
     algorithm = FCFS_ALG;
     preemptive = false;
 }
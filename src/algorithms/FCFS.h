@@ -1,9 +1,9 @@
 #ifndef FCFS_H
 #define FCFS_H
 
-#include "../Scheduler.h"
+#include "../core/SchedulingEngine.h"
 
-class FCFS : public Scheduler {
+class FCFS final : public PolicyScheduler<FCFS> {
 public:
     FCFS(int numCPUs = 1);
     
@@ -0,0 +1,215 @@
+#include "Gang.h"
+#include "../core/Checkpoint.h"
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <stdexcept>
+
+Gang::Gang(int numCPUs, GangPolicy gangPolicy, int quantum)
+    : PolicyScheduler<Gang>(numCPUs, gangPolicy == GANG_FCFS ? "Gang (FCFS)" :
+                         gangPolicy == GANG_EASY_BACKFILL ? "Gang (EASY Backfilling)" :
+                                                            "Gang (Time-Sliced)"),
+      policy(gangPolicy), fragmentedCPUTicks(0), backfilledJobs(0) {
+    algorithm = GANG_ALG;
+    preemptive = gangPolicy == GANG_TIME_SLICED;
+    timeQuantum = quantum;
+}
+
+void Gang::resetPolicy() {
+    waitQueue.clear();
+    runningJobs.clear();
+    fragmentedCPUTicks = 0;
+    backfilledJobs = 0;
+}
+
+void Gang::prepareRun(size_t processCount) {
+    waitQueue.reserve(processCount);
+    freeCPUs.reserve(cpus.size());
+    runningJobs.reserve(cpus.size());
+}
+
+// runningJobs and freeCPUs are rebuilt whenever they are used
+void Gang::savePolicyState(CheckpointWriter& writer) const {
+    writer.writeProcesses(waitQueue);
+    writer.writeInt(fragmentedCPUTicks);
+    writer.writeInt(backfilledJobs);
+}
+
+void Gang::restorePolicyState(CheckpointReader& reader) {
+    for (const auto& job : reader.readProcesses()) {
+        waitQueue.push(job);
+    }
+    fragmentedCPUTicks = reader.readInt();
+    backfilledJobs = reader.readInt32();
+}
+
+void Gang::schedule() {
+    for (const auto& process : processes) {
+        if (process->getWidth() > static_cast<int>(cpus.size())) {
+            throw std::invalid_argument("Process " + process->getProcessName() + " needs " +
+                                        std::to_string(process->getWidth()) + " CPUs but only " +
+                                        std::to_string(cpus.size()) + " are available");
+        }
+    }
+    
+    std::sort(processes.begin(), processes.end(),
+              [](const std::shared_ptr<Process>& a, const std::shared_ptr<Process>& b) {
+                  if (a->getArrivalTime() == b->getArrivalTime()) {
+                      return a->getProcessID() < b->getProcessID();
+                  }
+                  return a->getArrivalTime() < b->getArrivalTime();
+              });
+    
+    waitQueue.clear();
+    fragmentedCPUTicks = 0;
+    backfilledJobs = 0;
+}
+
+std::shared_ptr<Process> Gang::selectNextProcess() {
+    if (waitQueue.empty()) {
+        return nullptr;
+    }
+    
+    auto process = waitQueue.front();
+    waitQueue.pop();
+    return process;
+}
+
+void Gang::assignProcessesToCPUs() {
+    releaseFinishedFollowers();
+    
+    while (!readyQueue.empty()) {
+        waitQueue.push(readyQueue.front());
+        readyQueue.pop();
+    }
+    
+    collectFreeCPUs();
+    
+    // Start jobs in arrival order while the head fits
+    while (!waitQueue.empty() &&
+           waitQueue.front()->getWidth() <= static_cast<int>(freeCPUs.size())) {
+        startJob(selectNextProcess());
+    }
+    
+    if (policy == GANG_EASY_BACKFILL && !waitQueue.empty() && !freeCPUs.empty()) {
+        backfill();
+    }
+    
+    // CPUs left idle while work is queued are lost to fragmentation
+    if (!waitQueue.empty()) {
+        fragmentedCPUTicks += static_cast<long long>(freeCPUs.size());
+    }
+}
+
+void Gang::preempt(int cpuID) {
+    if (policy != GANG_TIME_SLICED) return;
+    
+    auto& cpu = cpus[cpuID];
+    if (cpu->getIsIdle() || !cpu->isLeadCPU()) return;
+    if (cpu->getCurrentTimeSlice() < timeQuantum) return;
+    if (waitQueue.empty() && readyQueue.empty()) return;
+    
+    auto job = cpu->getCurrentProcess();
+    if (!job || job->isCompleted()) return;
+    
+    // Deschedule the gang together at the end of the tick: the lead now, the
+    // followers once they have held their CPUs through it
+    cpu->releaseProcess();
+    readyQueue.push(job);
+}
+
+void Gang::startJob(const std::shared_ptr<Process>& job) {
+    int width = job->getWidth();
+    for (int i = 0; i < width; ++i) {
+        freeCPUs[i]->assignProcess(job, i == 0);
+    }
+    freeCPUs.erase(freeCPUs.begin(), freeCPUs.begin() + width);
+}
+
+// Followers of jobs that finished or whose lead was preempted
+void Gang::releaseFinishedFollowers() {
+    for (auto& cpu : cpus) {
+        auto current = cpu->getCurrentProcess();
+        if (current && !cpu->isLeadCPU() && (current->isCompleted() || current->getState() != RUNNING)) {
+            cpu->releaseProcess();
+        }
+    }
+}
+
+void Gang::collectFreeCPUs() {
+    freeCPUs.clear();
+    for (auto& cpu : cpus) {
+        if (cpu->getIsIdle()) {
+            freeCPUs.push_back(cpu.get());
+        }
+    }
+}
+
+// EASY backfilling: reserve the earliest start for the head job ("shadow time")
+// and let later jobs run now only if they finish before it or use CPUs the
+// head job will not need at that point
+void Gang::backfill() {
+    const auto& head = waitQueue.front();
+    
+    runningJobs.clear();
+    for (const auto& cpu : cpus) {
+        if (!cpu->getIsIdle() && cpu->isLeadCPU()) {
+            auto job = cpu->getCurrentProcess();
+            int runtime = static_cast<int>(job->getRemainingTime() / cpu->getEffectiveSpeed() + 0.999999);
+            runningJobs.push_back({currentTime + runtime, job->getWidth()});
+        }
+    }
+    std::sort(runningJobs.begin(), runningJobs.end());
+    
+    int available = static_cast<int>(freeCPUs.size());
+    int shadowTime = currentTime;
+    for (const auto& running : runningJobs) {
+        if (available >= head->getWidth()) break;
+        available += running.second;
+        shadowTime = running.first;
+    }
+    int extraCPUs = available - head->getWidth();
+    
+    for (size_t i = 1; i < waitQueue.size() && !freeCPUs.empty();) {
+        auto job = waitQueue[i];
+        int width = job->getWidth();
+        if (width > static_cast<int>(freeCPUs.size())) {
+            ++i;
+            continue;
+        }
+        
+        // The job would take the first `width` free CPUs; estimate its runtime
+        // at the slowest of them so a backfilled job cannot overrun the shadow
+        double speed = freeCPUs[0]->getEffectiveSpeed();
+        for (int c = 1; c < width; ++c) {
+            speed = std::min(speed, freeCPUs[c]->getEffectiveSpeed());
+        }
+        int runtime = static_cast<int>(job->getRemainingTime() / speed + 0.999999);
+        bool endsBeforeShadow = currentTime + runtime <= shadowTime;
+        
+        if (endsBeforeShadow || width <= extraCPUs) {
+            if (!endsBeforeShadow) {
+                extraCPUs -= width;
+            }
+            waitQueue.eraseAt(i);
+            startJob(job);
+            backfilledJobs++;
+        } else {
+            ++i;
+        }
+    }
+}
+
+double Gang::calculateFragmentation() const {
+    long long capacity = static_cast<long long>(cpus.size()) * currentTime;
+    return capacity > 0 ? (double)fragmentedCPUTicks / capacity * 100.0 : 0.0;
+}
+
+void Gang::printGangStatistics() const {
+    std::cout << "\n=== GANG SCHEDULING METRICS ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Average CPU Utilization: " << calculateAverageCPUUtilization() << "%" << std::endl;
+    std::cout << "Fragmentation: " << calculateFragmentation() << "% of CPU time idle while jobs waited ("
+              << fragmentedCPUTicks << " CPU-ticks)" << std::endl;
+    std::cout << "Backfilled Jobs: " << backfilledJobs << std::endl;
+}
\ No newline at end of file
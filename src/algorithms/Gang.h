@@ -0,0 +1,50 @@
+#ifndef GANG_H
+#define GANG_H
+
+#include "../core/SchedulingEngine.h"
+
+enum GangPolicy {
+    GANG_FCFS,            // strict arrival order, the head job blocks everyone behind it
+    GANG_EASY_BACKFILL,   // later jobs may jump ahead if they do not delay the head job
+    GANG_TIME_SLICED      // whole gangs are preempted together after each time quantum
+};
+
+class Gang final : public PolicyScheduler<Gang> {
+    friend class SchedulingEngine<Gang>;
+    
+private:
+    GangPolicy policy;
+    RingQueue<std::shared_ptr<Process>> waitQueue;
+    std::vector<CPU*> freeCPUs;
+    std::vector<std::pair<int, int>> runningJobs;   // (expected end, width)
+    long long fragmentedCPUTicks;
+    int backfilledJobs;
+    
+    void startJob(const std::shared_ptr<Process>& job);
+    void releaseFinishedFollowers();
+    void collectFreeCPUs();
+    void backfill();
+    
+public:
+    Gang(int numCPUs = 1, GangPolicy gangPolicy = GANG_EASY_BACKFILL, int quantum = 4);
+    
+    void schedule() override;
+    std::shared_ptr<Process> selectNextProcess() override;
+    void preempt(int cpuID) override;
+    size_t getWaitingCount() const override { return waitQueue.size() + readyQueue.size(); }
+    
+    // Gang metrics
+    long long getFragmentedCPUTicks() const { return fragmentedCPUTicks; }
+    int getBackfilledJobs() const { return backfilledJobs; }
+    double calculateFragmentation() const;
+    void printGangStatistics() const;
+    
+protected:
+    void assignProcessesToCPUs() override;
+    void resetPolicy() override;
+    void prepareRun(size_t processCount) override;
+    void savePolicyState(CheckpointWriter& writer) const override;
+    void restorePolicyState(CheckpointReader& reader) override;
+};
+
+#endif // GANG_H
\ No newline at end of file
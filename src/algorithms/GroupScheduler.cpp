@@ -0,0 +1,552 @@
+#include "GroupScheduler.h"
+#include "../core/Checkpoint.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+static const int DEFAULT_SHARES = 1024;
+static const int MAX_SHARES = 262144;
+
+// Virtual runtime an entry gains per tick is VRUNTIME_SCALE / shares; integer
+// arithmetic keeps runs exactly reproducible, and the scale keeps the
+// truncation under 0.03% at MAX_SHARES while 2^33 ticks still fit
+static const long long VRUNTIME_SCALE = 1LL << 30;
+
+static const int EXACT_RESPONSES = 128;
+static const int BUCKETS_PER_OCTAVE = 64;
+static const size_t RESPONSE_BUCKETS = EXACT_RESPONSES + 24 * BUCKETS_PER_OCTAVE;  // up to 2^31
+
+static std::string innerPolicyName(GroupInnerPolicy inner) {
+    switch (inner) {
+        case INNER_FCFS: return "FCFS";
+        case INNER_SJF: return "SJF";
+        case INNER_ROUND_ROBIN: return "Round Robin";
+        case INNER_PRIORITY: return "Priority";
+    }
+    return "FCFS";
+}
+
+GroupScheduler::GroupScheduler(int numCPUs, GroupInnerPolicy inner, int quantum)
+    : PolicyScheduler<GroupScheduler>(numCPUs, "Group Scheduling (" + innerPolicyName(inner) + ")"),
+      innerPolicy(inner), enqueueCount(0) {
+    algorithm = GROUP_ALG;
+    preemptive = true;
+    timeQuantum = quantum;
+    resetPolicy();
+}
+
+std::string GroupScheduler::normalizePath(const std::string& path) {
+    std::string normalized;
+    std::istringstream parts(path);
+    std::string part;
+    while (std::getline(parts, part, '/')) {
+        if (!part.empty()) {
+            normalized += "/" + part;
+        }
+    }
+    return normalized.empty() ? "/" : normalized;
+}
+
+size_t GroupScheduler::responseBucket(int responseTime) {
+    if (responseTime < EXACT_RESPONSES) {
+        return static_cast<size_t>(std::max(0, responseTime));
+    }
+    int octave = 0;
+    for (int v = responseTime; v >= 2 * BUCKETS_PER_OCTAVE; v >>= 1) ++octave;
+    return EXACT_RESPONSES + static_cast<size_t>((octave - 1) * BUCKETS_PER_OCTAVE +
+                                                 (responseTime >> octave) - BUCKETS_PER_OCTAVE);
+}
+
+int GroupScheduler::bucketLowerBound(size_t bucket) {
+    if (bucket < static_cast<size_t>(EXACT_RESPONSES)) {
+        return static_cast<int>(bucket);
+    }
+    int offset = static_cast<int>(bucket) - EXACT_RESPONSES;
+    int octave = offset / BUCKETS_PER_OCTAVE + 1;
+    return (BUCKETS_PER_OCTAVE + offset % BUCKETS_PER_OCTAVE) << octave;
+}
+
+void GroupScheduler::setShares(const std::string& path, int shares) {
+    if (shares < 1 || shares > MAX_SHARES) {
+        throw std::invalid_argument("Group " + path + " needs shares between 1 and " + std::to_string(MAX_SHARES));
+    }
+    std::string normalized = normalizePath(path);
+    configuredShares[normalized] = shares;
+    auto it = groupIndex.find(normalized);
+    if (it != groupIndex.end()) {
+        groups[it->second].shares = shares;
+    }
+}
+
+void GroupScheduler::buildRoot() {
+    groups.clear();
+    groupIndex.clear();
+    groups.emplace_back();
+    groups[0].path = "/";
+    groups[0].responseCounts.assign(RESPONSE_BUCKETS, 0);
+    groupIndex["/"] = 0;
+    groupIndex[""] = 0;
+}
+
+// Creates the group and any missing ancestors on first use, parents first.
+// The path as given is remembered too, so later lookups never normalize.
+int GroupScheduler::findGroup(const std::string& path) {
+    auto it = groupIndex.find(path);
+    if (it != groupIndex.end()) return it->second;
+    std::string normalized = normalizePath(path);
+    it = groupIndex.find(normalized);
+    if (it != groupIndex.end()) {
+        groupIndex[path] = it->second;
+        return it->second;
+    }
+    
+    int parent = findGroup(normalized.substr(0, std::max<size_t>(1, normalized.rfind('/'))));
+    GroupNode node;
+    node.path = normalized;
+    node.parent = parent;
+    auto configured = configuredShares.find(normalized);
+    node.shares = configured != configuredShares.end() ? configured->second : DEFAULT_SHARES;
+    node.responseCounts.assign(RESPONSE_BUCKETS, 0);
+    groups.push_back(std::move(node));
+    
+    int index = static_cast<int>(groups.size()) - 1;
+    groups[parent].children.push_back(index);
+    groupIndex[normalized] = index;
+    groupIndex[path] = index;
+    return index;
+}
+
+void GroupScheduler::clearRunState(GroupNode& node) {
+    node.vruntime = 0;
+    node.selfVruntime = 0;
+    node.queue.clear();
+    node.queued = 0;
+    node.runnable = 0;
+    node.runnableSelf = 0;
+    node.cpuTicks = 0;
+    node.arrived = 0;
+    node.completed = 0;
+    node.totalWaitingTime = 0;
+    node.totalTurnaroundTime = 0;
+    node.totalResponseTime = 0;
+    std::fill(node.responseCounts.begin(), node.responseCounts.end(), 0);
+}
+
+// Keeps the group tree and its storage; only the run state starts over
+void GroupScheduler::resetPolicy() {
+    if (groups.empty()) {
+        buildRoot();
+    }
+    for (auto& node : groups) {
+        clearRunState(node);
+    }
+    runningOn.assign(cpus.size(), nullptr);
+    runningGroup.assign(cpus.size(), -1);
+    selected.clear();
+    enqueueCount = 0;
+}
+
+// Creates every group of the workload up front and reserves each queue for
+// all of its processes, so the tick loop neither creates groups nor grows a
+// queue. Called again when a stopped run resumes, so it keeps run state.
+void GroupScheduler::prepareRun(size_t /* processCount */) {
+    runningOn.resize(cpus.size());
+    runningGroup.resize(cpus.size(), -1);
+    selected.reserve(cpus.size());
+    
+    for (auto& node : groups) {
+        node.members = 0;
+    }
+    for (const auto& process : processes) {
+        groups[findGroup(process->getGroup())].members++;
+    }
+    for (auto& node : groups) {
+        node.queue.reserve(node.members);
+    }
+}
+
+void GroupScheduler::schedule() {
+    resetPolicy();
+}
+
+// Entries that become busy start no earlier than the least virtual runtime
+// among their busy siblings, so time spent idle is not paid back. Each level
+// only reads its parent's other entries, so the chain is walked upwards.
+void GroupScheduler::activate(int group) {
+    for (int g = group; g > 0; g = groups[g].parent) {
+        GroupNode& node = groups[g];
+        if (node.runnable > 0) continue;
+        const GroupNode& parent = groups[node.parent];
+        bool found = parent.runnableSelf > 0;
+        long long least = parent.selfVruntime;
+        for (int sibling : parent.children) {
+            if (groups[sibling].runnable > 0 && (!found || groups[sibling].vruntime < least)) {
+                least = groups[sibling].vruntime;
+                found = true;
+            }
+        }
+        if (found) {
+            node.vruntime = std::max(node.vruntime, least);
+        }
+    }
+    
+    GroupNode& owner = groups[group];
+    if (owner.runnableSelf == 0) {
+        bool found = false;
+        long long least = 0;
+        for (int child : owner.children) {
+            if (groups[child].runnable > 0 && (!found || groups[child].vruntime < least)) {
+                least = groups[child].vruntime;
+                found = true;
+            }
+        }
+        if (found) {
+            owner.selfVruntime = std::max(owner.selfVruntime, least);
+        }
+    }
+    
+    owner.runnableSelf++;
+    for (int g = group; g >= 0; g = groups[g].parent) {
+        groups[g].runnable++;
+    }
+}
+
+void GroupScheduler::enqueue(const std::shared_ptr<Process>& process, int group) {
+    long long key = 0;
+    switch (innerPolicy) {
+        case INNER_FCFS: key = 0; break;
+        case INNER_SJF: key = process->getRemainingTime(); break;
+        case INNER_ROUND_ROBIN: key = enqueueCount++; break;
+        case INNER_PRIORITY: key = process->getPriority(); break;
+    }
+    groups[group].queue.push(QueueEntry{key, process->getArrivalTime(), process->getProcessID(), process});
+    for (int g = group; g >= 0; g = groups[g].parent) {
+        groups[g].queued++;
+    }
+}
+
+void GroupScheduler::onProcessArrival(std::shared_ptr<Process>) {
+    // The arrival is already in readyQueue; move it across exactly once
+    while (!readyQueue.empty()) {
+        auto process = readyQueue.front();
+        readyQueue.pop();
+        int group = findGroup(process->getGroup());
+        activate(group);
+        groups[group].arrived++;
+        enqueue(process, group);
+    }
+}
+
+// Descends through the waiting entry with the least virtual runtime, the
+// group's own processes first on a tie
+std::shared_ptr<Process> GroupScheduler::selectNextProcess() {
+    if (groups[0].queued == 0) {
+        return nullptr;
+    }
+    
+    int group = 0;
+    while (true) {
+        const GroupNode& node = groups[group];
+        bool found = !node.queue.empty();
+        long long least = node.selfVruntime;
+        int next = -1;
+        for (int child : node.children) {
+            if (groups[child].queued > 0 && (!found || groups[child].vruntime < least)) {
+                least = groups[child].vruntime;
+                next = child;
+                found = true;
+            }
+        }
+        if (next < 0) break;
+        group = next;
+    }
+    
+    auto process = groups[group].queue.top().process;
+    groups[group].queue.pop();
+    for (int g = group; g >= 0; g = groups[g].parent) {
+        groups[g].queued--;
+    }
+    selected.emplace_back(process.get(), group);
+    return process;
+}
+
+// Lets the usual placement run, then notes which group each newly
+// dispatched process belongs to
+void GroupScheduler::assignProcessesToCPUs() {
+    selected.clear();
+    Scheduler::assignProcessesToCPUs();
+    for (size_t i = 0; i < cpus.size(); ++i) {
+        const Process* occupant = cpus[i]->getOccupant();
+        if (occupant == runningOn[i].get()) continue;
+        for (const auto& choice : selected) {
+            if (choice.first == occupant) {
+                runningOn[i] = cpus[i]->getCurrentProcess();
+                runningGroup[i] = choice.second;
+                break;
+            }
+        }
+    }
+}
+
+void GroupScheduler::charge(int group) {
+    groups[group].cpuTicks++;
+    groups[group].selfVruntime += VRUNTIME_SCALE / DEFAULT_SHARES;
+    for (int g = group; g > 0; g = groups[g].parent) {
+        groups[g].vruntime += VRUNTIME_SCALE / groups[g].shares;
+    }
+}
+
+void GroupScheduler::finish(const Process& process, int group) {
+    GroupNode& node = groups[group];
+    node.completed++;
+    node.totalWaitingTime += process.getWaitingTime();
+    node.totalTurnaroundTime += process.getTurnaroundTime();
+    node.totalResponseTime += process.getResponseTime();
+    node.responseCounts[responseBucket(process.getResponseTime())]++;
+    node.runnableSelf--;
+    for (int g = group; g >= 0; g = groups[g].parent) {
+        groups[g].runnable--;
+    }
+}
+
+// Called after every CPU's tick: charges the tick to the groups of the
+// process that ran, and rotates it out once its quantum is used up
+void GroupScheduler::preempt(int cpuID) {
+    std::shared_ptr<Process>& process = runningOn[cpuID];
+    if (!process) return;
+    int group = runningGroup[cpuID];
+    charge(group);
+    
+    if (process->isCompleted()) {
+        finish(*process, group);
+        process.reset();
+        return;
+    }
+    
+    auto& cpu = cpus[cpuID];
+    if (cpu->getCurrentTimeSlice() < timeQuantum) return;
+    if (groups[0].queued == 0) {
+        cpu->resetTimeSlice();
+        return;
+    }
+    cpu->releaseProcess();
+    enqueue(process, group);
+    process.reset();
+}
+
+size_t GroupScheduler::getWaitingCount() const {
+    return readyQueue.size() + groups[0].queued;
+}
+
+std::string GroupScheduler::describePolicy() const {
+    std::string description = "shares";
+    for (const auto& entry : configuredShares) {
+        description += " " + entry.first + "=" + std::to_string(entry.second);
+    }
+    return description;
+}
+
+std::vector<GroupReport> GroupScheduler::getGroupReports() const {
+    // Parents are created before their children, so one backward pass sums
+    // every subtree into its root
+    std::vector<GroupReport> totals(groups.size());
+    for (size_t i = 0; i < groups.size(); ++i) {
+        const GroupNode& node = groups[i];
+        totals[i].processes = node.arrived;
+        totals[i].completed = node.completed;
+        totals[i].cpuShare = static_cast<double>(node.cpuTicks);
+        totals[i].avgWaitingTime = static_cast<double>(node.totalWaitingTime);
+        totals[i].avgTurnaroundTime = static_cast<double>(node.totalTurnaroundTime);
+        totals[i].avgResponseTime = static_cast<double>(node.totalResponseTime);
+    }
+    for (size_t i = groups.size(); i-- > 1;) {
+        GroupReport& parent = totals[groups[i].parent];
+        parent.processes += totals[i].processes;
+        parent.completed += totals[i].completed;
+        parent.cpuShare += totals[i].cpuShare;
+        parent.avgWaitingTime += totals[i].avgWaitingTime;
+        parent.avgTurnaroundTime += totals[i].avgTurnaroundTime;
+        parent.avgResponseTime += totals[i].avgResponseTime;
+    }
+    
+    // Subgroups that had processes, and the group's own processes as one
+    // entry, split the group's entitlement by shares
+    totals[0].entitledShare = 100.0;
+    for (size_t i = 0; i < groups.size(); ++i) {
+        double weights = groups[i].arrived > 0 ? DEFAULT_SHARES : 0.0;
+        for (int child : groups[i].children) {
+            weights += totals[child].processes > 0 ? groups[child].shares : 0;
+        }
+        for (int child : groups[i].children) {
+            if (totals[child].processes > 0) {
+                totals[child].entitledShare = totals[i].entitledShare * groups[child].shares / weights;
+            }
+        }
+    }
+    
+    // Tree order, skipping groups that never had processes
+    std::vector<GroupReport> reports;
+    std::vector<std::pair<int, int>> pending = {{0, 0}};   // (group, depth)
+    double capacity = static_cast<double>(cpus.size()) * currentTime;
+    while (!pending.empty()) {
+        int group = pending.back().first;
+        int depth = pending.back().second;
+        pending.pop_back();
+        const GroupNode& node = groups[group];
+        for (auto it = node.children.rbegin(); it != node.children.rend(); ++it) {
+            if (totals[*it].processes > 0) {
+                pending.emplace_back(*it, depth + 1);
+            }
+        }
+        
+        GroupReport report = totals[group];
+        report.path = node.path;
+        report.depth = depth;
+        report.shares = group == 0 ? 0 : node.shares;
+        report.cpuShare = capacity > 0 ? 100.0 * report.cpuShare / capacity : 0.0;
+        report.throughput = currentTime > 0 ? static_cast<double>(report.completed) / currentTime : 0.0;
+        if (report.completed > 0) {
+            report.avgWaitingTime /= report.completed;
+            report.avgTurnaroundTime /= report.completed;
+            report.avgResponseTime /= report.completed;
+            
+            // Nearest-rank 99th percentile over the whole subtree's histograms
+            std::vector<long long> counts(RESPONSE_BUCKETS, 0);
+            std::vector<int> subtree = {group};
+            while (!subtree.empty()) {
+                int g = subtree.back();
+                subtree.pop_back();
+                for (size_t b = 0; b < RESPONSE_BUCKETS; ++b) {
+                    counts[b] += groups[g].responseCounts[b];
+                }
+                subtree.insert(subtree.end(), groups[g].children.begin(), groups[g].children.end());
+            }
+            long long rank = std::max(1LL, static_cast<long long>(std::ceil(0.99 * report.completed)));
+            size_t bucket = 0;
+            long long seen = counts[0];
+            while (seen < rank && bucket + 1 < RESPONSE_BUCKETS) {
+                seen += counts[++bucket];
+            }
+            report.p99ResponseTime = bucketLowerBound(bucket);
+        }
+        reports.push_back(report);
+    }
+    return reports;
+}
+
+void GroupScheduler::printGroupStatistics() const {
+    std::cout << "\n=== GROUP SCHEDULING METRICS ===" << std::endl;
+    std::cout << std::left << std::setw(28) << "Group"
+              << std::setw(8) << "Shares"
+              << std::setw(12) << "Entitled %"
+              << std::setw(9) << "CPU %"
+              << std::setw(11) << "Processes"
+              << std::setw(12) << "Throughput"
+              << std::setw(11) << "Avg Wait"
+              << std::setw(16) << "Avg Turnaround"
+              << std::setw(14) << "Avg Response"
+              << "P99 Response" << std::endl;
+    std::cout << std::string(133, '-') << std::endl;
+    
+    for (const auto& report : getGroupReports()) {
+        std::cout << std::left << std::setw(28) << (std::string(2 * report.depth, ' ') + report.path)
+                  << std::setw(8) << (report.shares > 0 ? std::to_string(report.shares) : "-")
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(12) << report.entitledShare
+                  << std::setw(9) << report.cpuShare
+                  << std::setw(11) << report.processes
+                  << std::setprecision(4) << std::setw(12) << report.throughput
+                  << std::setprecision(2)
+                  << std::setw(11) << report.avgWaitingTime
+                  << std::setw(16) << report.avgTurnaroundTime
+                  << std::setw(14) << report.avgResponseTime
+                  << report.p99ResponseTime << std::endl;
+    }
+    std::cout << std::string(133, '-') << std::endl;
+}
+
+void GroupScheduler::savePolicyState(CheckpointWriter& writer) const {
+    writer.writeInt(static_cast<long long>(groups.size()));
+    for (const auto& node : groups) {
+        writer.writeString(node.path);
+        writer.writeInt(node.vruntime);
+        writer.writeInt(node.selfVruntime);
+        writer.writeInt(static_cast<long long>(node.queued));
+        writer.writeInt(static_cast<long long>(node.runnable));
+        writer.writeInt(static_cast<long long>(node.runnableSelf));
+        writer.writeInt(node.cpuTicks);
+        writer.writeInt(node.arrived);
+        writer.writeInt(node.completed);
+        writer.writeInt(node.totalWaitingTime);
+        writer.writeInt(node.totalTurnaroundTime);
+        writer.writeInt(node.totalResponseTime);
+        long long usedBuckets = std::count_if(node.responseCounts.begin(), node.responseCounts.end(),
+                                              [](long long count) { return count > 0; });
+        writer.writeInt(usedBuckets);
+        for (size_t b = 0; b < node.responseCounts.size(); ++b) {
+            if (node.responseCounts[b] > 0) {
+                writer.writeInt(static_cast<long long>(b));
+                writer.writeInt(node.responseCounts[b]);
+            }
+        }
+        const auto& entries = node.queue.items();
+        writer.writeInt(static_cast<long long>(entries.size()));
+        for (const auto& entry : entries) {
+            writer.writeInt(entry.key);
+            writer.writeProcess(entry.process);
+        }
+    }
+    for (size_t i = 0; i < cpus.size(); ++i) {
+        writer.writeProcess(runningOn[i]);
+        writer.writeInt(runningGroup[i]);
+    }
+    writer.writeInt(enqueueCount);
+}
+
+void GroupScheduler::restorePolicyState(CheckpointReader& reader) {
+    // Rebuilt in the saved order; this scheduler's tree may hold other groups
+    buildRoot();
+    long long count = reader.readInt();
+    for (long long i = 0; i < count; ++i) {
+        // Saved parents first, so the groups come back with the same indices
+        if (findGroup(reader.readString()) != i) {
+            throw std::runtime_error("Checkpoint group tree is inconsistent");
+        }
+        GroupNode& node = groups[i];
+        node.vruntime = reader.readInt();
+        node.selfVruntime = reader.readInt();
+        node.queued = static_cast<size_t>(reader.readInt());
+        node.runnable = static_cast<size_t>(reader.readInt());
+        node.runnableSelf = static_cast<size_t>(reader.readInt());
+        node.cpuTicks = reader.readInt();
+        node.arrived = reader.readInt();
+        node.completed = reader.readInt();
+        node.totalWaitingTime = reader.readInt();
+        node.totalTurnaroundTime = reader.readInt();
+        node.totalResponseTime = reader.readInt();
+        long long usedBuckets = reader.readInt();
+        for (long long b = 0; b < usedBuckets; ++b) {
+            long long bucket = reader.readInt();
+            if (bucket < 0 || bucket >= static_cast<long long>(RESPONSE_BUCKETS)) {
+                throw std::runtime_error("Checkpoint is corrupt");
+            }
+            node.responseCounts[static_cast<size_t>(bucket)] = reader.readInt();
+        }
+        std::vector<QueueEntry> entries(static_cast<size_t>(reader.readInt()));
+        for (auto& entry : entries) {
+            entry.key = reader.readInt();
+            entry.process = reader.readProcess();
+            entry.arrival = entry.process->getArrivalTime();
+            entry.id = entry.process->getProcessID();
+        }
+        node.queue.restoreItems(entries);
+    }
+    for (size_t i = 0; i < cpus.size(); ++i) {
+        runningOn[i] = reader.readProcess();
+        runningGroup[i] = reader.readInt32();
+    }
+    enqueueCount = reader.readInt();
+}
\ No newline at end of file
@@ -0,0 +1,142 @@
+#ifndef GROUPSCHEDULER_H
+#define GROUPSCHEDULER_H
+
+#include "../core/SchedulingEngine.h"
+#include <map>
+#include <unordered_map>
+
+// How processes are ordered inside one group
+enum GroupInnerPolicy {
+    INNER_FCFS,           // arrival order
+    INNER_SJF,            // shortest remaining time
+    INNER_ROUND_ROBIN,    // back of the queue after every quantum
+    INNER_PRIORITY        // lowest priority number
+};
+
+// One group of a run, its subgroups included
+struct GroupReport {
+    std::string path;
+    int depth = 0;
+    int shares = 0;
+    double entitledShare = 0.0;     // % of the machine with every group busy
+    double cpuShare = 0.0;          // % of the machine actually used
+    long long processes = 0;
+    long long completed = 0;
+    double throughput = 0.0;        // completions per time unit
+    double avgWaitingTime = 0.0;
+    double avgTurnaroundTime = 0.0;
+    double avgResponseTime = 0.0;
+    int p99ResponseTime = 0;
+};
+
+// Hierarchical proportional-share scheduling, as cgroup CPU shares. Processes
+// belong to a group path such as "/web/frontend" (none: the root "/"), and
+// every level of the tree splits CPU time among its busy entries in
+// proportion to their shares (default 1024, at most 262144 as in cgroup v1).
+// The processes a group holds itself count as one more entry with the
+// default shares.
+//
+// Like CFS, every entry has a virtual runtime that grows by the CPU time it
+// receives divided by its shares; an idle CPU goes to the process found by
+// descending through the entry with the least virtual runtime at each level.
+// An entry that becomes busy again starts no lower than the least virtual
+// runtime among its busy siblings, so idling earns no credit. The inner policy
+// orders processes inside a group, and a process gives up its CPU after each
+// quantum whenever anything else waits.
+//
+// The group tree outlives reset(), and each group's response times are kept
+// as a fixed-size histogram, so reruns allocate nothing and streaming runs
+// stay bounded.
+class GroupScheduler final : public PolicyScheduler<GroupScheduler> {
+    friend class SchedulingEngine<GroupScheduler>;
+    
+private:
+    struct QueueEntry {
+        long long key;
+        int arrival;
+        int id;
+        std::shared_ptr<Process> process;
+    };
+    
+    struct EntryOrder {
+        bool operator()(const QueueEntry& a, const QueueEntry& b) const {
+            if (a.key != b.key) return a.key > b.key;
+            if (a.arrival != b.arrival) return a.arrival > b.arrival;
+            return a.id > b.id;
+        }
+    };
+    
+    struct GroupNode {
+        std::string path;
+        int parent = -1;
+        std::vector<int> children;
+        int shares = 1024;
+        long long vruntime = 0;         // as an entry of its parent
+        long long selfVruntime = 0;     // its own processes as one entry among its children
+        ReservedHeap<QueueEntry, EntryOrder> queue;
+        size_t queued = 0;              // waiting in the subtree
+        size_t runnable = 0;            // waiting or running in the subtree
+        size_t runnableSelf = 0;        // waiting or running in this group itself
+        size_t members = 0;             // processes of the run in this group, for reserving
+        
+        // This group's own processes
+        long long cpuTicks = 0;
+        long long arrived = 0;
+        long long completed = 0;
+        long long totalWaitingTime = 0;
+        long long totalTurnaroundTime = 0;
+        long long totalResponseTime = 0;
+        std::vector<long long> responseCounts;  // per histogram bucket, see responseBucket()
+    };
+    
+    GroupInnerPolicy innerPolicy;
+    std::map<std::string, int> configuredShares;
+    std::vector<GroupNode> groups;
+    std::unordered_map<std::string, int> groupIndex;
+    std::vector<std::shared_ptr<Process>> runningOn;    // per CPU, as assigned this tick
+    std::vector<int> runningGroup;
+    std::vector<std::pair<const Process*, int>> selected;   // (process, group) picked this tick
+    long long enqueueCount;
+    
+    int findGroup(const std::string& path);
+    void buildRoot();
+    void clearRunState(GroupNode& node);
+    void activate(int group);
+    void enqueue(const std::shared_ptr<Process>& process, int group);
+    void charge(int group);
+    void finish(const Process& process, int group);
+    
+public:
+    GroupScheduler(int numCPUs = 1, GroupInnerPolicy inner = INNER_ROUND_ROBIN, int quantum = 4);
+    
+    // Shares of the group at `path`; takes effect from the next run
+    void setShares(const std::string& path, int shares);
+    
+    void schedule() override;
+    std::shared_ptr<Process> selectNextProcess() override;
+    void onProcessArrival(std::shared_ptr<Process> process) override;
+    void preempt(int cpuID) override;
+    size_t getWaitingCount() const override;
+    
+    // Every group in tree order, each including its subgroups
+    std::vector<GroupReport> getGroupReports() const;
+    void printGroupStatistics() const;
+    
+    // "/a/b" for "a/b/", "/" for ""
+    static std::string normalizePath(const std::string& path);
+    
+    // Log-linear histogram of response times: exact below 128, then 64
+    // buckets per power of two, so a percentile is within 1/64 of its value
+    static size_t responseBucket(int responseTime);
+    static int bucketLowerBound(size_t bucket);
+    
+protected:
+    void assignProcessesToCPUs() override;
+    void resetPolicy() override;
+    void prepareRun(size_t processCount) override;
+    std::string describePolicy() const override;
+    void savePolicyState(CheckpointWriter& writer) const override;
+    void restorePolicyState(CheckpointReader& reader) override;
+};
+
+#endif // GROUPSCHEDULER_H
\ No newline at end of file
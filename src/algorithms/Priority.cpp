@@ -1,7 +1,8 @@
 #include "Priority.h"
+#include "../core/Checkpoint.h"
 
 Priority::Priority(int numCPUs, bool preempt) 
-    : Scheduler(numCPUs, preempt ? "Preemptive Priority" : "Non-preemptive Priority") {
+    : PolicyScheduler<Priority>(numCPUs, preempt ? "Preemptive Priority" : "Non-preemptive Priority") {
     algorithm = PRIORITY_ALG;
     preemptive = preempt;
 }
@@ -22,22 +23,16 @@ std::shared_ptr<Process> Priority::selectNextProcess() {
     return process;
 }
 
-void Priority::onProcessArrival(std::shared_ptr<Process> process) {
+void Priority::onProcessArrival(std::shared_ptr<Process>) {
+    // The arrival is already in readyQueue; move it across exactly once so a
+    // process never sits in priorityQueue twice
+    updatePriorityQueue();
+    
     if (preemptive) {
-        for (auto& cpu : cpus) {
-            if (!cpu->getIsIdle()) {
-                auto currentProcess = cpu->getCurrentProcess();
-                if (currentProcess && 
-                    process->getPriority() < currentProcess->getPriority()) {
-                    cpu->releaseProcess();
-                    priorityQueue.push(currentProcess);
-                    cpu->assignProcess(process);
-                    return;
-                }
-            }
+        for (size_t i = 0; i < cpus.size(); ++i) {
+            preempt(static_cast<int>(i));
         }
     }
-    priorityQueue.push(process);
 }
 
 void Priority::preempt(int cpuID) {
@@ -63,4 +58,12 @@ void Priority::updatePriorityQueue() {
         priorityQueue.push(readyQueue.front());
         readyQueue.pop();
     }
+}
+
+void Priority::savePolicyState(CheckpointWriter& writer) const {
+    writer.writeProcesses(priorityQueue.items());
+}
+
+void Priority::restorePolicyState(CheckpointReader& reader) {
+    priorityQueue.restoreItems(reader.readProcesses());
 }
\ No newline at end of file
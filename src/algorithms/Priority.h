@@ -1,10 +1,9 @@
 #ifndef PRIORITY_H
 #define PRIORITY_H
 
-#include "../Scheduler.h"
-#include <queue>
+#include "../core/SchedulingEngine.h"
 
-class Priority : public Scheduler {
+class Priority final : public PolicyScheduler<Priority> {
 private:
     struct PriorityComparator {
         bool operator()(const std::shared_ptr<Process>& a, 
@@ -19,9 +18,7 @@ private:
         }
     };
     
-    std::priority_queue<std::shared_ptr<Process>, 
-                       std::vector<std::shared_ptr<Process>>, 
-                       PriorityComparator> priorityQueue;
+    ReservedHeap<std::shared_ptr<Process>, PriorityComparator> priorityQueue;
 
 public:
     Priority(int numCPUs = 1, bool preempt = false);
@@ -30,9 +27,14 @@ public:
     std::shared_ptr<Process> selectNextProcess() override;
     void onProcessArrival(std::shared_ptr<Process> process) override;
     void preempt(int cpuID) override;
+    size_t getWaitingCount() const override { return priorityQueue.size() + readyQueue.size(); }
 
 private:
     void updatePriorityQueue();
+    void resetPolicy() override { priorityQueue.clear(); }
+    void prepareRun(size_t processCount) override { priorityQueue.reserve(processCount); }
+    void savePolicyState(CheckpointWriter& writer) const override;
+    void restorePolicyState(CheckpointReader& reader) override;
 };
 
 #endif // PRIORITY_H
\ No newline at end of file
@@ -2,7 +2,7 @@
 #include <algorithm>
 
 RoundRobin::RoundRobin(int quantum, int numCPUs) 
-    : Scheduler(numCPUs, "Round Robin") {
+    : PolicyScheduler<RoundRobin>(numCPUs, "Round Robin") {
     algorithm = RR_ALG;
     preemptive = true;
     timeQuantum = quantum;
@@ -1,9 +1,9 @@
 #ifndef ROUNDROBIN_H
 #define ROUNDROBIN_H
 
-#include "../Scheduler.h"
+#include "../core/SchedulingEngine.h"
 
-class RoundRobin : public Scheduler {
+class RoundRobin final : public PolicyScheduler<RoundRobin> {
 public:
     RoundRobin(int quantum, int numCPUs = 1);
     
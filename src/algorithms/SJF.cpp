@@ -1,8 +1,9 @@
 #include "SJF.h"
+#include "../core/Checkpoint.h"
 #include <iostream>
 
 SJF::SJF(int numCPUs, bool preempt) 
-    : Scheduler(numCPUs, preempt ? "Shortest Remaining Time First (SRTF)" : "Shortest Job First (SJF)") {
+    : PolicyScheduler<SJF>(numCPUs, preempt ? "Shortest Remaining Time First (SRTF)" : "Shortest Job First (SJF)") {
     algorithm = preempt ? SRTF_ALG : SJF_ALG;
     preemptive = preempt;
 }
@@ -23,23 +24,17 @@ std::shared_ptr<Process> SJF::selectNextProcess() {
     return process;
 }
 
-void SJF::onProcessArrival(std::shared_ptr<Process> process) {
+void SJF::onProcessArrival(std::shared_ptr<Process>) {
+    // The arrival is already in readyQueue; move it across exactly once so a
+    // process never sits in sjfQueue twice
+    updateSJFQueue();
+    
     if (preemptive) {
         // Check if we need to preempt any running process
-        for (auto& cpu : cpus) {
-            if (!cpu->getIsIdle()) {
-                auto currentProcess = cpu->getCurrentProcess();
-                if (currentProcess && 
-                    process->getRemainingTime() < currentProcess->getRemainingTime()) {
-                    cpu->releaseProcess();
-                    sjfQueue.push(currentProcess);
-                    cpu->assignProcess(process);
-                    return;
-                }
-            }
+        for (size_t i = 0; i < cpus.size(); ++i) {
+            preempt(static_cast<int>(i));
         }
     }
-    sjfQueue.push(process);
 }
 
 void SJF::preempt(int cpuID) {
@@ -65,4 +60,12 @@ void SJF::updateSJFQueue() {
         sjfQueue.push(readyQueue.front());
         readyQueue.pop();
     }
+}
+
+void SJF::savePolicyState(CheckpointWriter& writer) const {
+    writer.writeProcesses(sjfQueue.items());
+}
+
+void SJF::restorePolicyState(CheckpointReader& reader) {
+    sjfQueue.restoreItems(reader.readProcesses());
 }
\ No newline at end of file
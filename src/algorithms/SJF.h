@@ -1,10 +1,9 @@
 #ifndef SJF_H
 #define SJF_H
 
-#include "../Scheduler.h"
-#include <queue>
+#include "../core/SchedulingEngine.h"
 
-class SJF : public Scheduler {
+class SJF final : public PolicyScheduler<SJF> {
 private:
     struct SJFComparator {
         bool operator()(const std::shared_ptr<Process>& a, 
@@ -19,9 +18,7 @@ private:
         }
     };
     
-    std::priority_queue<std::shared_ptr<Process>, 
-                       std::vector<std::shared_ptr<Process>>, 
-                       SJFComparator> sjfQueue;
+    ReservedHeap<std::shared_ptr<Process>, SJFComparator> sjfQueue;
 
 public:
     SJF(int numCPUs = 1, bool preempt = false);
@@ -30,9 +27,14 @@ public:
     std::shared_ptr<Process> selectNextProcess() override;
     void onProcessArrival(std::shared_ptr<Process> process) override;
     void preempt(int cpuID) override;
+    size_t getWaitingCount() const override { return sjfQueue.size() + readyQueue.size(); }
 
 private:
     void updateSJFQueue();
+    void resetPolicy() override { sjfQueue.clear(); }
+    void prepareRun(size_t processCount) override { sjfQueue.reserve(processCount); }
+    void savePolicyState(CheckpointWriter& writer) const override;
+    void restorePolicyState(CheckpointReader& reader) override;
 };
 
 #endif // SJF_H
\ No newline at end of file
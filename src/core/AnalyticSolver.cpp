@@ -0,0 +1,186 @@
+#include "AnalyticSolver.h"
+#include <algorithm>
+#include <climits>
+#include <functional>
+#include <iostream>
+#include <queue>
+
+bool AnalyticSolver::supports(const Scheduler& scheduler, std::string* reason) {
+    auto reject = [reason](const char* why) {
+        if (reason) *reason = why;
+        return false;
+    };
+    
+    if (scheduler.preemptive) {
+        return reject("preemptive policy");
+    }
+    if (scheduler.algorithm != FCFS_ALG && scheduler.algorithm != SJF_ALG &&
+        scheduler.algorithm != PRIORITY_ALG) {
+        return reject("policy has no closed form");
+    }
+    if (scheduler.placement != PLACE_BY_INDEX) {
+        return reject("speed-aware core placement");
+    }
+    if (scheduler.currentTime != 0) {
+        return reject("simulation already started");
+    }
+    for (const auto& cpu : scheduler.cpus) {
+        if (cpu->getEffectiveSpeed() != 1.0 || cpu->hasFrequencyScaling() || !cpu->getIsIdle()) {
+            return reject("CPUs are not identical reference-speed cores");
+        }
+    }
+    for (const auto& process : scheduler.processes) {
+        if (process->getState() != NEW) {
+            return reject("processes already started");
+        }
+    }
+    return true;
+}
+
+AnalyticSchedule AnalyticSolver::solve(const Scheduler& scheduler) {
+    const auto& processes = scheduler.processes;
+    const int count = static_cast<int>(processes.size());
+    const int numCPUs = static_cast<int>(scheduler.cpus.size());
+    
+    AnalyticSchedule schedule;
+    schedule.startTimes.assign(count, -1);
+    schedule.completionTimes.assign(count, -1);
+    schedule.assignedCPU.assign(count, -1);
+    schedule.cpuBusyTime.assign(numCPUs, 0);
+    if (count == 0 || numCPUs == 0) return schedule;
+    
+    // Admission order; for FCFS this is also the dispatch order
+    std::vector<int> arrivals(count);
+    for (int i = 0; i < count; ++i) arrivals[i] = i;
+    std::sort(arrivals.begin(), arrivals.end(), [&processes](int a, int b) {
+        if (processes[a]->getArrivalTime() == processes[b]->getArrivalTime()) {
+            return processes[a]->getProcessID() < processes[b]->getProcessID();
+        }
+        return processes[a]->getArrivalTime() < processes[b]->getArrivalTime();
+    });
+    
+    // Same ordering as the SJF and Priority ready queues ("a runs after b")
+    const SchedulingAlgorithm algorithm = scheduler.algorithm;
+    auto runsAfter = [&processes, algorithm](int a, int b) {
+        const Process& pa = *processes[a];
+        const Process& pb = *processes[b];
+        int keyA = algorithm == SJF_ALG ? pa.getRemainingTime() : pa.getPriority();
+        int keyB = algorithm == SJF_ALG ? pb.getRemainingTime() : pb.getPriority();
+        if (keyA != keyB) return keyA > keyB;
+        if (pa.getArrivalTime() != pb.getArrivalTime()) return pa.getArrivalTime() > pb.getArrivalTime();
+        return pa.getProcessID() > pb.getProcessID();
+    };
+    std::priority_queue<int, std::vector<int>, decltype(runsAfter)> readyHeap(runsAfter);
+    size_t readyHead = 0;      // FCFS: arrivals[readyHead, admitted) are ready
+    size_t admitted = 0;
+    
+    std::priority_queue<int, std::vector<int>, std::greater<int>> idleCPUs;
+    for (int cpu = 0; cpu < numCPUs; ++cpu) idleCPUs.push(cpu);
+    std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>,
+                        std::greater<std::pair<int, int>>> busyCPUs;
+    
+    auto hasReady = [&]() {
+        return algorithm == FCFS_ALG ? readyHead < admitted : !readyHeap.empty();
+    };
+    auto popReady = [&]() {
+        if (algorithm == FCFS_ALG) return arrivals[readyHead++];
+        int next = readyHeap.top();
+        readyHeap.pop();
+        return next;
+    };
+    
+    // The tick loop starts at time 0 and admits anything that arrived by then
+    int time = std::max(0, processes[arrivals[0]]->getArrivalTime());
+    int dispatched = 0;
+    while (dispatched < count) {
+        while (!busyCPUs.empty() && busyCPUs.top().first <= time) {
+            idleCPUs.push(busyCPUs.top().second);
+            busyCPUs.pop();
+        }
+        while (admitted < arrivals.size() && processes[arrivals[admitted]]->getArrivalTime() <= time) {
+            if (algorithm != FCFS_ALG) readyHeap.push(arrivals[admitted]);
+            admitted++;
+        }
+        
+        while (!idleCPUs.empty() && hasReady()) {
+            int cpu = idleCPUs.top();
+            idleCPUs.pop();
+            int index = popReady();
+            
+            // A zero-length burst still holds its CPU for one tick
+            int duration = std::max(1, processes[index]->getRemainingTime());
+            schedule.startTimes[index] = time;
+            schedule.completionTimes[index] = time + duration;
+            schedule.assignedCPU[index] = cpu;
+            schedule.cpuBusyTime[cpu] += duration;
+            schedule.makespan = std::max(schedule.makespan, time + duration);
+            busyCPUs.push({time + duration, cpu});
+            dispatched++;
+        }
+        
+        // Next instant at which a CPU frees up or, with a CPU free, a process arrives
+        int next = INT_MAX;
+        if (!busyCPUs.empty()) next = busyCPUs.top().first;
+        if (!idleCPUs.empty() && admitted < arrivals.size()) {
+            next = std::min(next, processes[arrivals[admitted]]->getArrivalTime());
+        }
+        time = next;
+    }
+    return schedule;
+}
+
+void AnalyticSolver::apply(Scheduler& scheduler, const AnalyticSchedule& schedule) {
+    std::vector<int> dispatches(scheduler.cpus.size(), 0);
+    for (size_t i = 0; i < scheduler.processes.size(); ++i) {
+        auto& process = scheduler.processes[i];
+        int duration = schedule.completionTimes[i] - schedule.startTimes[i];
+        process->executeFor(duration, schedule.startTimes[i], duration, schedule.assignedCPU[i]);
+        dispatches[schedule.assignedCPU[i]]++;
+    }
+    for (size_t cpu = 0; cpu < scheduler.cpus.size(); ++cpu) {
+        scheduler.cpus[cpu]->accountTime(schedule.cpuBusyTime[cpu],
+                                         schedule.makespan - schedule.cpuBusyTime[cpu],
+                                         dispatches[cpu]);
+    }
+    scheduler.currentTime = schedule.makespan;
+}
+
+int AnalyticSolver::compare(const Scheduler& simulated, const AnalyticSchedule& schedule) {
+    const int maxReported = 5;
+    int mismatches = 0;
+    auto report = [&mismatches](const std::string& what, int expected, int actual) {
+        if (mismatches++ < maxReported) {
+            std::cout << "  Mismatch: " << what << " simulated " << actual
+                      << ", solved " << expected << std::endl;
+        }
+    };
+    
+    for (size_t i = 0; i < simulated.processes.size(); ++i) {
+        const auto& process = simulated.processes[i];
+        if (process->getStartTime() != schedule.startTimes[i]) {
+            report(process->getProcessName() + " start", schedule.startTimes[i], process->getStartTime());
+        }
+        if (process->getCompletionTime() != schedule.completionTimes[i]) {
+            report(process->getProcessName() + " completion", schedule.completionTimes[i],
+                   process->getCompletionTime());
+        }
+    }
+    std::vector<int> dispatches(simulated.cpus.size(), 0);
+    for (int cpu : schedule.assignedCPU) {
+        if (cpu >= 0) dispatches[cpu]++;
+    }
+    for (size_t cpu = 0; cpu < simulated.cpus.size(); ++cpu) {
+        if (simulated.cpus[cpu]->getBusyTime() != schedule.cpuBusyTime[cpu]) {
+            report("CPU " + std::to_string(cpu) + " busy time", schedule.cpuBusyTime[cpu],
+                   simulated.cpus[cpu]->getBusyTime());
+        }
+        if (simulated.cpus[cpu]->getDispatchCount() != dispatches[cpu]) {
+            report("CPU " + std::to_string(cpu) + " dispatches", dispatches[cpu],
+                   simulated.cpus[cpu]->getDispatchCount());
+        }
+    }
+    if (simulated.currentTime != schedule.makespan) {
+        report("makespan", schedule.makespan, simulated.currentTime);
+    }
+    return mismatches;
+}
\ No newline at end of file
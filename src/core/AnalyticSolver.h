@@ -0,0 +1,41 @@
+#ifndef ANALYTICSOLVER_H
+#define ANALYTICSOLVER_H
+
+#include "../Scheduler.h"
+#include <string>
+#include <vector>
+
+// A complete non-preemptive schedule, indexed like Scheduler::processes at the
+// time it was solved (FCFS reorders them in schedule())
+struct AnalyticSchedule {
+    std::vector<int> startTimes;
+    std::vector<int> completionTimes;
+    std::vector<int> assignedCPU;
+    std::vector<int> cpuBusyTime;
+    int makespan = 0;
+};
+
+// Closed-form solver for non-preemptive FCFS, SJF and Priority. Without
+// preemption a process runs uninterrupted from the moment it is dispatched, so
+// the whole schedule follows from the arrival order, the policy's ready-queue
+// order and a heap of CPU free times: O(N log N + N log C) instead of one loop
+// iteration per time unit. Ties are broken exactly like the tick loop (lowest
+// idle CPU first, the policy's comparator among ready processes).
+class AnalyticSolver {
+public:
+    // True when the scheduler's policy and machine are covered; otherwise
+    // `reason` (if given) says why the tick loop is needed
+    static bool supports(const Scheduler& scheduler, std::string* reason = nullptr);
+    
+    // Computes the schedule without touching the scheduler
+    static AnalyticSchedule solve(const Scheduler& scheduler);
+    
+    // Writes a schedule into the processes and CPUs as if it had been simulated
+    static void apply(Scheduler& scheduler, const AnalyticSchedule& schedule);
+    
+    // Compares a schedule with the state left by a simulated run; prints up to
+    // a few mismatches and returns the number of them
+    static int compare(const Scheduler& simulated, const AnalyticSchedule& schedule);
+};
+
+#endif // ANALYTICSOLVER_H
\ No newline at end of file
@@ -1,46 +1,151 @@
 #include "CPU.h"
+#include "Checkpoint.h"
 #include <iostream>
 #include <iomanip>
+#include <sstream>
+#include <stdexcept>
 
-CPU::CPU(int id) : cpuID(id), isIdle(true), totalIdleTime(0), 
-                   totalBusyTime(0), currentTimeSlice(0) {}
+CPU::CPU(int id, double speed) : cpuID(id), isIdle(true), totalIdleTime(0),
+                   totalBusyTime(0), currentTimeSlice(0), leadsProcess(true), dispatchCount(0),
+                   preemptionCount(0), speedFactor(1.0),
+                   frequencyLevels(1, 1.0), frequencyLevel(0), transitionLatency(0),
+                   transitionRemaining(0), idleDownclock(false) {
+    setSpeedFactor(speed);
+}
 
-void CPU::assignProcess(std::shared_ptr<Process> process) {
+// A parallel job occupies several CPUs at once; only the lead CPU advances it,
+// the others are held busy until the job finishes or is descheduled
+void CPU::assignProcess(std::shared_ptr<Process> process, bool lead) {
     if (!process) return;
     
     currentProcess = process;
     isIdle = false;
     currentTimeSlice = 0;
+    leadsProcess = lead;
+    dispatchCount++;
     process->setState(RUNNING);
+    
+    if (idleDownclock) {
+        requestFrequencyLevel(static_cast<int>(frequencyLevels.size()) - 1);
+    }
 }
 
 void CPU::releaseProcess() {
-    if (currentProcess) {
+    if (currentProcess && leadsProcess) {
         if (currentProcess->isCompleted()) {
             currentProcess->setState(TERMINATED);
         } else {
             currentProcess->setState(READY);
+            preemptionCount++;
         }
-        currentProcess = nullptr;
     }
+    currentProcess = nullptr;
+    leadsProcess = true;
     isIdle = true;
     currentTimeSlice = 0;
 }
 
-void CPU::tick(int currentTime) {
+bool CPU::tick(int currentTime) {
     if (isIdle) {
         totalIdleTime++;
+        if (transitionRemaining > 0) {
+            transitionRemaining--;
+        }
+        
+        // Only a core that stayed idle through a tick downclocks; one released
+        // and redispatched in the same tick keeps its level
+        if (idleDownclock) {
+            requestFrequencyLevel(0);
+        }
     } else {
         totalBusyTime++;
         currentTimeSlice++;
         
-        if (currentProcess) {
-            currentProcess->executeFor(1, currentTime);
+        if (currentProcess && !leadsProcess) {
+            // Held for the whole tick unless the job finished before it began
+            if (!currentProcess->isCompleted() || currentProcess->getCompletionTime() > currentTime) {
+                currentProcess->holdFor(1, currentTime, cpuID);
+            }
+            if (currentProcess->isCompleted()) {
+                releaseProcess();
+            }
+        } else if (currentProcess) {
+            // The core is occupied but retires no work while it changes frequency.
+            // Fractional progress stays with the process, so a core slower than
+            // 1/quantum still completes preempted work over several dispatches.
+            int work = 0;
+            if (transitionRemaining > 0) {
+                transitionRemaining--;
+            } else {
+                double credit = currentProcess->getWorkCredit() + getEffectiveSpeed();
+                work = static_cast<int>(credit);
+                currentProcess->setWorkCredit(credit - work);
+            }
+            
+            currentProcess->executeFor(1, currentTime, work, cpuID);
             if (currentProcess->isCompleted()) {
                 releaseProcess();
+                return true;
             }
         }
     }
+    return false;
+}
+
+void CPU::setSpeedFactor(double speed) {
+    if (speed <= 0.0) {
+        throw std::invalid_argument("CPU speed factor must be positive");
+    }
+    speedFactor = speed;
+}
+
+void CPU::setFrequencyLevels(const std::vector<double>& levels, int latency) {
+    if (levels.empty() || latency < 0) {
+        throw std::invalid_argument("CPU needs at least one frequency level and a non-negative latency");
+    }
+    for (double level : levels) {
+        if (level <= 0.0) {
+            throw std::invalid_argument("CPU frequency levels must be positive");
+        }
+    }
+    
+    // Levels are ordered slowest to fastest; start at full speed
+    frequencyLevels = levels;
+    frequencyLevel = static_cast<int>(levels.size()) - 1;
+    transitionLatency = latency;
+    transitionRemaining = 0;
+}
+
+void CPU::requestFrequencyLevel(int level) {
+    if (level < 0 || level >= static_cast<int>(frequencyLevels.size())) return;
+    if (level == frequencyLevel) return;
+    
+    frequencyLevel = level;
+    transitionRemaining = transitionLatency;
+}
+
+void CPU::setIdleDownclock(bool enabled) {
+    idleDownclock = enabled;
+    
+    // An idle core configured this way starts parked at its lowest level
+    if (idleDownclock && isIdle) {
+        frequencyLevel = 0;
+        transitionRemaining = 0;
+    }
+}
+
+double CPU::getEffectiveSpeed() const {
+    return speedFactor * frequencyLevels[frequencyLevel];
+}
+
+std::string CPU::describeSetup() const {
+    std::ostringstream text;
+    text << std::setprecision(17) << "speed " << speedFactor << " levels";
+    for (double level : frequencyLevels) {
+        text << " " << level;
+    }
+    text << " latency " << transitionLatency << " downclock " << idleDownclock;
+    return text.str();
 }
 
 double CPU::getUtilization() const {
@@ -50,20 +155,59 @@ double CPU::getUtilization() const {
 
 void CPU::reset() {
     currentProcess = nullptr;
+    leadsProcess = true;
     isIdle = true;
     totalIdleTime = 0;
     totalBusyTime = 0;
     currentTimeSlice = 0;
+    dispatchCount = 0;
+    preemptionCount = 0;
+    frequencyLevel = idleDownclock ? 0 : static_cast<int>(frequencyLevels.size()) - 1;
+    transitionRemaining = 0;
+}
+
+void CPU::saveState(CheckpointWriter& writer) const {
+    writer.writeProcess(currentProcess);
+    writer.writeBool(isIdle);
+    writer.writeInt(totalIdleTime);
+    writer.writeInt(totalBusyTime);
+    writer.writeInt(currentTimeSlice);
+    writer.writeBool(leadsProcess);
+    writer.writeInt(dispatchCount);
+    writer.writeInt(preemptionCount);
+    writer.writeInt(frequencyLevel);
+    writer.writeInt(transitionRemaining);
+}
+
+void CPU::restoreState(CheckpointReader& reader) {
+    currentProcess = reader.readProcess();
+    isIdle = reader.readBool();
+    totalIdleTime = reader.readInt32();
+    totalBusyTime = reader.readInt32();
+    currentTimeSlice = reader.readInt32();
+    leadsProcess = reader.readBool();
+    dispatchCount = reader.readInt32();
+    preemptionCount = reader.readInt32();
+    int level = reader.readInt32();
+    if (level < 0 || level >= static_cast<int>(frequencyLevels.size())) {
+        throw std::invalid_argument("Checkpoint was taken with different CPU frequency levels");
+    }
+    frequencyLevel = level;
+    transitionRemaining = reader.readInt32();
 }
 
 void CPU::displayStatus() const {
-    std::cout << "CPU " << cpuID << ": ";
+    std::cout << "CPU " << cpuID << " (x" << std::fixed << std::setprecision(2)
+              << getEffectiveSpeed() << "): ";
     if (isIdle) {
         std::cout << "IDLE";
     } else {
         std::cout << "Running " << currentProcess->getProcessName()
                   << " (Remaining: " << currentProcess->getRemainingTime() << ")";
     }
+    if (transitionRemaining > 0) {
+        std::cout << " [switching frequency]";
+    }
     std::cout << " | Utilization: " << std::fixed << std::setprecision(1) 
               << getUtilization() << "%" << std::endl;
 }
\ No newline at end of file
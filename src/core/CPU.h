@@ -3,6 +3,11 @@
 
 #include "../Process.h"
 #include <memory>
+#include <string>
+#include <vector>
+
+class CheckpointWriter;
+class CheckpointReader;
 
 class CPU {
 private:
@@ -12,27 +17,64 @@ private:
     int totalIdleTime;
     int totalBusyTime;
     int currentTimeSlice;
+    bool leadsProcess;
+    int dispatchCount;
+    int preemptionCount;
 
+    // Heterogeneous cores: work retired per tick = speedFactor * frequency level
+    double speedFactor;
+    std::vector<double> frequencyLevels;
+    int frequencyLevel;
+    int transitionLatency;
+    int transitionRemaining;
+    bool idleDownclock;
+    
 public:
-    CPU(int id);
+    CPU(int id, double speed = 1.0);
     ~CPU() = default;
     
     // Process management
-    void assignProcess(std::shared_ptr<Process> process);
+    void assignProcess(std::shared_ptr<Process> process, bool lead = true);
     void releaseProcess();
     std::shared_ptr<Process> getCurrentProcess() const { return currentProcess; }
+    const Process* getOccupant() const { return currentProcess.get(); }   // without sharing ownership
+    bool isLeadCPU() const { return leadsProcess; }
+    int getDispatchCount() const { return dispatchCount; }  // processes switched in
+    int getPreemptionCount() const { return preemptionCount; }  // led processes switched out unfinished
     
     // State management
     bool getIsIdle() const { return isIdle; }
-    void tick(int currentTime);
+    bool tick(int currentTime);     // true when the process it leads finished
     int getCurrentTimeSlice() const { return currentTimeSlice; }
     void resetTimeSlice() { currentTimeSlice = 0; }
     
+    // Speed and frequency states
+    void setSpeedFactor(double speed);
+    double getSpeedFactor() const { return speedFactor; }
+    void setFrequencyLevels(const std::vector<double>& levels, int latency);
+    void requestFrequencyLevel(int level);
+    int getFrequencyLevel() const { return frequencyLevel; }
+    void setIdleDownclock(bool enabled);
+    bool isTransitioning() const { return transitionRemaining > 0; }
+    bool hasFrequencyScaling() const { return frequencyLevels.size() > 1; }
+    double getEffectiveSpeed() const;
+    std::string describeSetup() const;  // speed and frequency configuration as text
+    
     // Statistics
     double getUtilization() const;
     int getIdleTime() const { return totalIdleTime; }
     int getBusyTime() const { return totalBusyTime; }
     int getTotalTime() const { return totalIdleTime + totalBusyTime; }
+    // Credits time scheduled without ticking, e.g. by AnalyticSolver
+    void accountTime(int busy, int idle, int dispatches) {
+        totalBusyTime += busy;
+        totalIdleTime += idle;
+        dispatchCount += dispatches;
+    }
+    
+    // Run state; speed and frequency configuration belong to the scheduler's setup
+    void saveState(CheckpointWriter& writer) const;
+    void restoreState(CheckpointReader& reader);
     
     // Utility
     void reset();
@@ -0,0 +1,102 @@
+#include "Checkpoint.h"
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+
+CheckpointWriter::CheckpointWriter(const std::vector<std::shared_ptr<Process>>& processes) {
+    indices.reserve(processes.size());
+    for (size_t i = 0; i < processes.size(); ++i) {
+        indices[processes[i].get()] = static_cast<long long>(i);
+    }
+}
+
+void CheckpointWriter::writeInt(long long value) {
+    uint64_t bits = static_cast<uint64_t>(value);
+    for (int i = 0; i < 8; ++i) {
+        bytes.push_back(static_cast<char>((bits >> (8 * i)) & 0xff));
+    }
+}
+
+void CheckpointWriter::writeDouble(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeInt(static_cast<long long>(bits));
+}
+
+void CheckpointWriter::writeString(const std::string& value) {
+    writeInt(static_cast<long long>(value.size()));
+    bytes += value;
+}
+
+void CheckpointWriter::writeProcess(const Process* process) {
+    if (!process) {
+        writeInt(-1);
+        return;
+    }
+    auto it = indices.find(process);
+    if (it == indices.end()) {
+        throw std::logic_error("Checkpoint refers to a process the scheduler does not own");
+    }
+    writeInt(it->second);
+}
+
+CheckpointReader::CheckpointReader(const std::string& data)
+    : bytes(data), position(0), processes(nullptr) {}
+
+long long CheckpointReader::readInt() {
+    if (bytes.size() - position < 8) {
+        throw std::runtime_error("Checkpoint is truncated");
+    }
+    uint64_t bits = 0;
+    for (int i = 0; i < 8; ++i) {
+        bits |= static_cast<uint64_t>(static_cast<unsigned char>(bytes[position++])) << (8 * i);
+    }
+    return static_cast<long long>(bits);
+}
+
+int CheckpointReader::readInt32() {
+    long long value = readInt();
+    if (value < INT_MIN || value > INT_MAX) {
+        throw std::runtime_error("Checkpoint value out of range");
+    }
+    return static_cast<int>(value);
+}
+
+double CheckpointReader::readDouble() {
+    uint64_t bits = static_cast<uint64_t>(readInt());
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+std::string CheckpointReader::readString() {
+    long long length = readInt();
+    if (length < 0 || static_cast<unsigned long long>(length) > bytes.size() - position) {
+        throw std::runtime_error("Checkpoint is truncated");
+    }
+    std::string value = bytes.substr(position, static_cast<size_t>(length));
+    position += static_cast<size_t>(length);
+    return value;
+}
+
+std::shared_ptr<Process> CheckpointReader::readProcess() {
+    long long index = readInt();
+    if (index == -1) return nullptr;
+    if (!processes || index < 0 || static_cast<size_t>(index) >= processes->size()) {
+        throw std::runtime_error("Checkpoint refers to an unknown process");
+    }
+    return (*processes)[static_cast<size_t>(index)];
+}
+
+std::vector<std::shared_ptr<Process>> CheckpointReader::readProcesses() {
+    long long count = readInt();
+    if (count < 0 || static_cast<unsigned long long>(count) > (bytes.size() - position) / 8) {
+        throw std::runtime_error("Checkpoint is truncated");
+    }
+    std::vector<std::shared_ptr<Process>> sequence;
+    sequence.reserve(static_cast<size_t>(count));
+    for (long long i = 0; i < count; ++i) {
+        sequence.push_back(readProcess());
+    }
+    return sequence;
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Process;
+
+// Binary encoding of simulation state. Integers are 8 bytes little-endian and
+// doubles keep their exact bits, so a restored run continues bit-identically.
+// Processes are referred to by their position in the scheduler's process
+// list, which a checkpoint records up front.
+class CheckpointWriter {
+private:
+    std::string bytes;
+    std::unordered_map<const Process*, long long> indices;
+    
+public:
+    explicit CheckpointWriter(const std::vector<std::shared_ptr<Process>>& processes);
+    
+    void writeInt(long long value);
+    void writeDouble(double value);
+    void writeBool(bool value) { writeInt(value ? 1 : 0); }
+    void writeString(const std::string& value);
+    void writeProcess(const Process* process);     // null allowed
+    void writeProcess(const std::shared_ptr<Process>& process) { writeProcess(process.get()); }
+    
+    // A queue of processes front to back; anything indexable with size()
+    template <typename Sequence>
+    void writeProcesses(const Sequence& sequence) {
+        writeInt(static_cast<long long>(sequence.size()));
+        for (size_t i = 0; i < sequence.size(); ++i) {
+            writeProcess(sequence[i]);
+        }
+    }
+    
+    const std::string& data() const { return bytes; }
+};
+
+// Reads what a CheckpointWriter wrote; throws std::runtime_error when the data
+// runs out or does not match what is expected
+class CheckpointReader {
+private:
+    const std::string& bytes;
+    size_t position;
+    const std::vector<std::shared_ptr<Process>>* processes;
+    
+public:
+    explicit CheckpointReader(const std::string& data);
+    
+    // Processes that writeProcess indices refer to
+    void setProcesses(const std::vector<std::shared_ptr<Process>>& list) { processes = &list; }
+    
+    long long readInt();
+    int readInt32();
+    double readDouble();
+    bool readBool() { return readInt() != 0; }
+    std::string readString();
+    std::shared_ptr<Process> readProcess();
+    std::vector<std::shared_ptr<Process>> readProcesses();
+    bool atEnd() const { return position == bytes.size(); }
+};
+
+#endif // CHECKPOINT_H
\ No newline at end of file
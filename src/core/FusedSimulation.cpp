@@ -0,0 +1,64 @@
+#include "FusedSimulation.h"
+#include "../utils/ArrivalStream.h"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+void FusedSimulation::addScheduler(Scheduler& scheduler) {
+    if (!schedulers.empty() && scheduler.getCurrentTime() != schedulers.front()->getCurrentTime()) {
+        throw std::invalid_argument("Fused schedulers must start at the same time");
+    }
+    schedulers.push_back(&scheduler);
+}
+
+void FusedSimulation::run(ArrivalStream& stream, int tickMillis) {
+    if (schedulers.empty()) {
+        throw std::invalid_argument("No schedulers to run");
+    }
+    for (auto* scheduler : schedulers) {
+        scheduler->startProfile();
+        scheduler->startObserving();
+        scheduler->schedule();
+    }
+    
+    auto wallStart = std::chrono::steady_clock::now();
+    int startTime = schedulers.front()->currentTime;
+    int time = startTime;
+    auto pending = stream.next();
+    std::vector<Scheduler*> active = schedulers;
+    
+    while (true) {
+        // A scheduler stops once the stream is exhausted and its own
+        // processes have finished; until then all of them tick
+        if (!pending) {
+            active.erase(std::remove_if(active.begin(), active.end(), [](Scheduler* scheduler) {
+                return scheduler->areAllProcessesCompleted();
+            }), active.end());
+            if (active.empty()) break;
+        }
+        
+        while (pending && pending->getArrivalTime() <= time) {
+            for (size_t i = 1; i < schedulers.size(); ++i) {
+                schedulers[i]->processes.push_back(std::make_shared<Process>(*pending));
+            }
+            schedulers.front()->processes.push_back(std::move(pending));
+            pending = stream.next();
+        }
+        
+        for (auto* scheduler : active) {
+            scheduler->step();
+            scheduler->retireCompletedProcesses();
+        }
+        time++;
+        
+        if (tickMillis > 0) {
+            std::this_thread::sleep_until(wallStart + std::chrono::milliseconds(
+                static_cast<long long>(tickMillis) * (time - startTime)));
+        }
+    }
+    
+    for (auto* scheduler : schedulers) {
+        scheduler->finishRun();
+    }
+}
\ No newline at end of file
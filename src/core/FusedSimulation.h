@@ -0,0 +1,30 @@
+#ifndef FUSEDSIMULATION_H
+#define FUSEDSIMULATION_H
+
+#include "../Scheduler.h"
+#include <vector>
+
+class ArrivalStream;
+
+// Streams one arrival source through several schedulers in lock-step. Each
+// arrival is parsed once and handed to every scheduler (the first one keeps
+// the parsed process, the others get copies), while each scheduler keeps its
+// own CPUs, queues and statistics. Every scheduler ticks exactly as it would
+// in its own Scheduler::runStreaming, so the results are the same as streaming
+// the source once per policy, without reading it more than once.
+class FusedSimulation {
+private:
+    std::vector<Scheduler*> schedulers;
+    
+public:
+    // Schedulers must be at the same time; they are not owned
+    void addScheduler(Scheduler& scheduler);
+    
+    // Runs until the stream is exhausted and every scheduler has finished.
+    // With tickMillis > 0 each time unit is paced to that much wall time.
+    void run(ArrivalStream& stream, int tickMillis = 0);
+    
+    const std::vector<Scheduler*>& getSchedulers() const { return schedulers; }
+};
+
+#endif // FUSEDSIMULATION_H
\ No newline at end of file
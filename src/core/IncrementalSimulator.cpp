@@ -0,0 +1,127 @@
+#include "IncrementalSimulator.h"
+#include <algorithm>
+#include <stdexcept>
+
+IncrementalSimulator::IncrementalSimulator(SchedulerFactory schedulerFactory,
+                                           const std::vector<std::shared_ptr<Process>>& processes,
+                                           int interval, size_t snapshotLimit)
+    : factory(schedulerFactory), snapshotInterval(std::max(1, interval)),
+      maxSnapshots(std::max<size_t>(2, snapshotLimit)), earliestEdit(INT_MAX), resumeTime(0), simulatedTicks(0) {
+    for (const auto& process : processes) {
+        definitions.push_back(std::make_shared<Process>(process->getProcessID(), process->getArrivalTime(),
+                                                        process->getBurstTime(), process->getPriority(),
+                                                        process->getProcessName()));
+        definitions.back()->setWidth(process->getWidth());
+        definitions.back()->setGroup(process->getGroup());
+    }
+}
+
+std::shared_ptr<Process> IncrementalSimulator::find(int processID) const {
+    for (const auto& process : definitions) {
+        if (process->getProcessID() == processID) {
+            return process;
+        }
+    }
+    throw std::invalid_argument("No process with ID " + std::to_string(processID));
+}
+
+void IncrementalSimulator::markEdited(int arrivalTime) {
+    earliestEdit = std::min(earliestEdit, arrivalTime);
+}
+
+// Runs the scheduler to the end in snapshot-sized steps, checkpointing at
+// each stop
+void IncrementalSimulator::simulate(std::unique_ptr<Scheduler> fresh) {
+    resumeTime = fresh->getCurrentTime();
+    int stopTime = resumeTime;
+    while (true) {
+        stopTime = stopTime > INT_MAX - snapshotInterval ? INT_MAX : stopTime + snapshotInterval;
+        if (fresh->runUntil(stopTime)) break;
+        snapshots[fresh->getCurrentTime()] = fresh->checkpoint();
+        if (snapshots.size() > maxSnapshots) {
+            thinSnapshots();
+        }
+    }
+    simulatedTicks = static_cast<long long>(fresh->getCurrentTime()) - resumeTime;
+    scheduler = std::move(fresh);
+    earliestEdit = INT_MAX;
+}
+
+// Drops every other snapshot, keeping the latest
+void IncrementalSimulator::thinSnapshots() {
+    bool keep = true;
+    for (auto it = snapshots.end(); it != snapshots.begin();) {
+        --it;
+        if (!keep) {
+            it = snapshots.erase(it);
+        }
+        keep = !keep;
+    }
+    if (snapshotInterval <= INT_MAX / 2) {
+        snapshotInterval *= 2;
+    }
+}
+
+const Scheduler& IncrementalSimulator::run() {
+    snapshots.clear();
+    auto fresh = factory();
+    fresh->setQuiet(true);
+    fresh->setWorkload(std::make_shared<const Workload>(definitions));
+    simulate(std::move(fresh));
+    return *scheduler;
+}
+
+void IncrementalSimulator::setBurstTime(int processID, int burst) {
+    auto process = find(processID);
+    markEdited(process->getArrivalTime());
+    auto edited = std::make_shared<Process>(processID, process->getArrivalTime(), burst,
+                                            process->getPriority(), process->getProcessName());
+    edited->setWidth(process->getWidth());
+    edited->setGroup(process->getGroup());
+    std::replace(definitions.begin(), definitions.end(), process, edited);
+}
+
+void IncrementalSimulator::setPriority(int processID, int priority) {
+    auto process = find(processID);
+    markEdited(process->getArrivalTime());
+    process->setPriority(priority);
+}
+
+void IncrementalSimulator::addProcess(const Process& process) {
+    markEdited(process.getArrivalTime());
+    definitions.push_back(std::make_shared<Process>(process.getProcessID(), process.getArrivalTime(),
+                                                    process.getBurstTime(), process.getPriority(),
+                                                    process.getProcessName()));
+    definitions.back()->setWidth(process.getWidth());
+    definitions.back()->setGroup(process.getGroup());
+}
+
+void IncrementalSimulator::removeProcess(int processID) {
+    auto process = find(processID);
+    markEdited(process->getArrivalTime());
+    definitions.erase(std::find(definitions.begin(), definitions.end(), process));
+}
+
+const Scheduler& IncrementalSimulator::rerun() {
+    if (!scheduler) {
+        return run();
+    }
+    
+    // Later snapshots hold the old workload's future and are dropped
+    snapshots.erase(snapshots.upper_bound(earliestEdit), snapshots.end());
+    auto fresh = factory();
+    fresh->setQuiet(true);
+    fresh->setWorkload(std::make_shared<const Workload>(definitions));
+    if (!snapshots.empty()) {
+        fresh->restore(std::prev(snapshots.end())->second, true);
+    }
+    simulate(std::move(fresh));
+    return *scheduler;
+}
+
+const Scheduler& IncrementalSimulator::getScheduler() const {
+    if (!scheduler) {
+        throw std::logic_error("Nothing has been simulated yet");
+    }
+    return *scheduler;
+}
\ No newline at end of file
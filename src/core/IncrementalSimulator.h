@@ -0,0 +1,63 @@
+#ifndef INCREMENTALSIMULATOR_H
+#define INCREMENTALSIMULATOR_H
+
+#include "../Scheduler.h"
+#include <climits>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Re-simulates a workload after edits without starting over. A run keeps a
+// checkpoint every snapshotInterval ticks; after edits, rerun() restores the
+// latest one taken before the earliest edited arrival and simulates only
+// from there. Nothing before that arrival depends on the edited processes,
+// so the result equals a full run of the edited workload. Past maxSnapshots
+// every other snapshot is dropped and the interval doubles, so memory stays
+// bounded on long runs.
+class IncrementalSimulator {
+public:
+    typedef std::function<std::unique_ptr<Scheduler>()> SchedulerFactory;
+    
+private:
+    SchedulerFactory factory;
+    std::vector<std::shared_ptr<Process>> definitions;
+    int snapshotInterval;
+    size_t maxSnapshots;
+    std::map<int, std::string> snapshots;   // by time
+    std::unique_ptr<Scheduler> scheduler;
+    int earliestEdit;                       // INT_MAX when nothing changed since the last run
+    int resumeTime;
+    long long simulatedTicks;
+    
+    std::shared_ptr<Process> find(int processID) const;
+    void markEdited(int arrivalTime);
+    void simulate(std::unique_ptr<Scheduler> fresh);
+    void thinSnapshots();
+    
+public:
+    IncrementalSimulator(SchedulerFactory schedulerFactory,
+                         const std::vector<std::shared_ptr<Process>>& processes,
+                         int interval = 1000, size_t snapshotLimit = 16);
+    
+    // Full run, keeping snapshots
+    const Scheduler& run();
+    
+    // Workload edits, applied by the next rerun(); unknown IDs throw
+    void setBurstTime(int processID, int burst);
+    void setPriority(int processID, int priority);
+    void addProcess(const Process& process);
+    void removeProcess(int processID);
+    
+    // Continues from the latest snapshot not after the earliest edit
+    const Scheduler& rerun();
+    
+    const Scheduler& getScheduler() const;
+    const std::vector<std::shared_ptr<Process>>& getWorkload() const { return definitions; }
+    int getResumeTime() const { return resumeTime; }          // where the last run started
+    long long getSimulatedTicks() const { return simulatedTicks; }  // ticks the last run simulated
+    size_t getSnapshotCount() const { return snapshots.size(); }
+};
+
+#endif // INCREMENTALSIMULATOR_H
\ No newline at end of file
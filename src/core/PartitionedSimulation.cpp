@@ -0,0 +1,243 @@
+#include "PartitionedSimulation.h"
+#include <algorithm>
+#include <stdexcept>
+
+PartitionedSimulation::PartitionedSimulation(SchedulerFactory factory, int numCPUs, int partitionCount,
+                                             int windowTicks)
+    : window(std::max(1, windowTicks)), threads(1), windows(0), windowEnd(0), lastArrivalsPlaced(false),
+      nextPartition(0), windowGeneration(0), busyWorkers(0), stopping(false) {
+    if (partitionCount < 1 || numCPUs < partitionCount || numCPUs % partitionCount != 0) {
+        throw std::invalid_argument("CPU count must be a positive multiple of the partition count");
+    }
+    for (int i = 0; i < partitionCount; ++i) {
+        partitions.push_back(factory(numCPUs / partitionCount));
+        partitions.back()->setQuiet(true);
+    }
+    setThreads(static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+void PartitionedSimulation::addProcesses(const std::vector<std::shared_ptr<Process>>& processes) {
+    for (const auto& process : processes) {
+        if (process) {
+            arrivals.push_back(process);
+        }
+    }
+}
+
+void PartitionedSimulation::setThreads(int count) {
+    threads = std::max(1, count);
+}
+
+// Arrivals before windowEnd go to the partition with the fewest processes;
+// admission itself happens inside the partition at the arrival time
+void PartitionedSimulation::placeArrivals(size_t& cursor, int windowEnd) {
+    std::vector<size_t> load(partitions.size());
+    for (size_t p = 0; p < partitions.size(); ++p) {
+        load[p] = partitions[p]->processes.size();
+    }
+    for (; cursor < arrivals.size() && arrivals[cursor]->getArrivalTime() < windowEnd; ++cursor) {
+        size_t target = std::min_element(load.begin(), load.end()) - load.begin();
+        partitions[target]->processes.push_back(arrivals[cursor]);
+        load[target]++;
+    }
+}
+
+// Steps partitions taken from the shared counter to windowEnd. Once no
+// arrivals remain, a partition stops as soon as its processes have finished,
+// as a streaming run does.
+void PartitionedSimulation::stepPartitions() {
+    for (size_t p = nextPartition++; p < partitions.size(); p = nextPartition++) {
+        Scheduler& partition = *partitions[p];
+        while (partition.currentTime < windowEnd &&
+               !(lastArrivalsPlaced && partition.areAllProcessesCompleted())) {
+            partition.step();
+            partition.retireCompletedProcesses();
+        }
+    }
+}
+    
+void PartitionedSimulation::helperLoop() {
+    long long seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(poolMutex);
+            windowStarted.wait(lock, [&]() { return stopping || windowGeneration != seen; });
+            if (stopping) return;
+            seen = windowGeneration;
+        }
+        
+        std::exception_ptr error;
+        try {
+            stepPartitions();
+        } catch (...) {
+            error = std::current_exception();
+        }
+        
+        std::lock_guard<std::mutex> lock(poolMutex);
+        if (error && !workerError) {
+            workerError = error;
+        }
+        if (--busyWorkers == 0) {
+            windowFinished.notify_one();
+        }
+    }
+}
+
+// As in QuantumTuner, a lone worker is the calling thread itself, so
+// single-threaded runs keep non-atomic shared_ptr copies
+void PartitionedSimulation::startHelpers() {
+    size_t workers = std::min(partitions.size(), static_cast<size_t>(threads));
+    stopping = false;
+    workerError = nullptr;
+    for (size_t i = 1; i < workers; ++i) {
+        helpers.emplace_back(&PartitionedSimulation::helperLoop, this);
+    }
+}
+
+void PartitionedSimulation::stopHelpers() {
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        stopping = true;
+    }
+    windowStarted.notify_all();
+    for (auto& helper : helpers) {
+        helper.join();
+    }
+    helpers.clear();
+}
+
+// Releases the helpers into one window, steps partitions alongside them and
+// waits at the barrier until every partition has reached the window's end
+void PartitionedSimulation::runWindow(int end, bool lastPlaced) {
+    windowEnd = end;
+    lastArrivalsPlaced = lastPlaced;
+    nextPartition = 0;
+    
+    if (helpers.empty()) {
+        stepPartitions();
+    } else {
+        {
+            std::lock_guard<std::mutex> lock(poolMutex);
+            busyWorkers = helpers.size();
+            windowGeneration++;
+        }
+        windowStarted.notify_all();
+        stepPartitions();
+        
+        std::unique_lock<std::mutex> lock(poolMutex);
+        windowFinished.wait(lock, [&]() { return busyWorkers == 0; });
+        if (workerError) {
+            std::rethrow_exception(workerError);
+        }
+    }
+    windows++;
+}
+
+void PartitionedSimulation::run() {
+    std::stable_sort(arrivals.begin(), arrivals.end(),
+                     [](const std::shared_ptr<Process>& a, const std::shared_ptr<Process>& b) {
+                         return a->getArrivalTime() < b->getArrivalTime();
+                     });
+    
+    // Policies check the workload in schedule() (Gang rejects jobs wider than
+    // a partition); partitions start empty, so one sees a copy of it first
+    Scheduler& first = *partitions.front();
+    first.processes = arrivals;
+    first.schedule();
+    first.processes.clear();
+    for (auto& partition : partitions) {
+        partition->startProfile();
+        partition->schedule();
+    }
+    
+    startHelpers();
+    try {
+        size_t cursor = 0;
+        int windowStart = 0;
+        while (true) {
+            int end = windowStart + window;
+            placeArrivals(cursor, end);
+            bool lastPlaced = cursor == arrivals.size();
+            if (lastPlaced && std::all_of(partitions.begin(), partitions.end(),
+                                          [](const std::unique_ptr<Scheduler>& partition) {
+                                              return partition->areAllProcessesCompleted();
+                                          })) {
+                break;
+            }
+            runWindow(end, lastPlaced);
+            windowStart = end;
+        }
+    } catch (...) {
+        stopHelpers();
+        throw;
+    }
+    stopHelpers();
+    
+    for (auto& partition : partitions) {
+        partition->finishRun();
+    }
+}
+
+int PartitionedSimulation::getEndTime() const {
+    int end = 0;
+    for (const auto& partition : partitions) {
+        end = std::max(end, partition->getCurrentTime());
+    }
+    return end;
+}
+
+long long PartitionedSimulation::getProcessCount() const {
+    long long count = 0;
+    for (const auto& partition : partitions) {
+        count += partition->getProcessCount();
+    }
+    return count;
+}
+
+double PartitionedSimulation::calculateAverageWaitingTime() const {
+    long long count = getProcessCount();
+    if (count == 0) return 0.0;
+    
+    double total = 0.0;
+    for (const auto& partition : partitions) {
+        total += partition->calculateAverageWaitingTime() * partition->getProcessCount();
+    }
+    return total / count;
+}
+
+double PartitionedSimulation::calculateAverageTurnaroundTime() const {
+    long long count = getProcessCount();
+    if (count == 0) return 0.0;
+    
+    double total = 0.0;
+    for (const auto& partition : partitions) {
+        total += partition->calculateAverageTurnaroundTime() * partition->getProcessCount();
+    }
+    return total / count;
+}
+
+double PartitionedSimulation::calculateAverageResponseTime() const {
+    long long count = getProcessCount();
+    if (count == 0) return 0.0;
+    
+    double total = 0.0;
+    for (const auto& partition : partitions) {
+        total += partition->calculateAverageResponseTime() * partition->getProcessCount();
+    }
+    return total / count;
+}
+
+// Partitions that finished early stopped their clocks, so their CPUs count
+// as idle until the last partition finished
+double PartitionedSimulation::calculateAverageCPUUtilization() const {
+    long long busy = 0;
+    long long cpuCount = 0;
+    for (const auto& partition : partitions) {
+        for (const auto& cpu : partition->cpus) {
+            busy += cpu->getBusyTime();
+            cpuCount++;
+        }
+    }
+    long long capacity = cpuCount * getEndTime();
+    return capacity > 0 ? static_cast<double>(busy) / capacity * 100.0 : 0.0;
+}
\ No newline at end of file
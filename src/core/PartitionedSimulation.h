@@ -0,0 +1,79 @@
+#ifndef PARTITIONEDSIMULATION_H
+#define PARTITIONEDSIMULATION_H
+
+#include "../Scheduler.h"
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Simulates a large machine as independent partitions of CPUs, each a
+// scheduler of the chosen policy with its own run queue, spread over worker
+// threads. Time advances in windows of `window` ticks. Partitions only
+// interact at window boundaries, where the arrivals of the next window are
+// placed, each on the partition with the fewest processes (live at the
+// boundary plus placed so far), the lowest index on a tie. Within a window
+// every partition therefore depends on nothing but its own state, so the
+// window is a safe lookahead and the partitions run it concurrently. Results
+// depend on the partition count and window, never on the thread count.
+//
+// Worker threads are started once per run and meet the calling thread at a
+// barrier after every window, rather than being created for each window.
+//
+// Processes are updated in place; CPU numbers in their execution histories
+// count within their partition.
+class PartitionedSimulation {
+public:
+    typedef std::function<std::unique_ptr<Scheduler>(int cpus)> SchedulerFactory;
+    
+private:
+    std::vector<std::unique_ptr<Scheduler>> partitions;
+    std::vector<std::shared_ptr<Process>> arrivals;     // by arrival time
+    int window;
+    int threads;
+    long long windows;
+    
+    // The window being stepped, and the pool that steps it
+    int windowEnd;
+    bool lastArrivalsPlaced;
+    std::atomic<size_t> nextPartition;
+    std::vector<std::thread> helpers;
+    std::mutex poolMutex;
+    std::condition_variable windowStarted;
+    std::condition_variable windowFinished;
+    long long windowGeneration;
+    size_t busyWorkers;
+    bool stopping;
+    std::exception_ptr workerError;
+    
+    void placeArrivals(size_t& cursor, int windowEnd);
+    void stepPartitions();
+    void helperLoop();
+    void startHelpers();
+    void stopHelpers();
+    void runWindow(int end, bool lastPlaced);
+    
+public:
+    PartitionedSimulation(SchedulerFactory factory, int numCPUs, int partitionCount, int windowTicks = 64);
+    
+    void addProcesses(const std::vector<std::shared_ptr<Process>>& processes);
+    void setThreads(int count);
+    void run();
+    
+    // Across all partitions
+    int getEndTime() const;
+    long long getProcessCount() const;
+    long long getWindowCount() const { return windows; }
+    double calculateAverageWaitingTime() const;
+    double calculateAverageTurnaroundTime() const;
+    double calculateAverageResponseTime() const;
+    double calculateAverageCPUUtilization() const;
+    
+    const std::vector<std::unique_ptr<Scheduler>>& getPartitions() const { return partitions; }
+};
+
+#endif // PARTITIONEDSIMULATION_H
\ No newline at end of file
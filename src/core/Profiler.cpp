@@ -0,0 +1,50 @@
+#include "Profiler.h"
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+const char* Profiler::phaseName(ProfilePhase phase) {
+    switch (phase) {
+        case PHASE_ADMIT: return "Admit arrivals";
+        case PHASE_ASSIGN: return "Assign to CPUs";
+        case PHASE_SELECT: return "  Select next";
+        case PHASE_TICK: return "CPU tick";
+        case PHASE_PREEMPT: return "Preempt";
+        default: return "Phase";
+    }
+}
+
+void Profiler::print(const RunProfile& profile) {
+    // Selection runs inside assignment, so it is left out of the total
+    long long total = 0;
+    for (int phase = 0; phase < PHASE_COUNT; ++phase) {
+        if (phase != PHASE_SELECT) total += profile.nanoseconds[phase];
+    }
+    
+    std::cout << "\n=== TICK LOOP PROFILE ===" << std::endl;
+    std::cout << std::left << std::setw(20) << "Phase"
+              << std::setw(14) << "Calls"
+              << std::setw(14) << "Total ms"
+              << std::setw(12) << "ns/call"
+              << "Share" << std::endl;
+    std::cout << std::string(70, '-') << std::endl;
+    for (int phase = 0; phase < PHASE_COUNT; ++phase) {
+        long long calls = profile.calls[phase];
+        long long nanoseconds = profile.nanoseconds[phase];
+        std::cout << std::left << std::setw(20) << phaseName(static_cast<ProfilePhase>(phase))
+                  << std::setw(14) << calls
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(14) << nanoseconds / 1e6
+                  << std::setw(12) << (calls > 0 ? static_cast<double>(nanoseconds) / calls : 0.0)
+                  << (total > 0 ? 100.0 * nanoseconds / total : 0.0) << "%" << std::endl;
+    }
+    std::cout << std::string(70, '-') << std::endl;
+    
+    std::cout << "Ticks: " << profile.ticks
+              << "  Arrivals: " << profile.arrivals
+              << "  Completions: " << profile.completions << std::endl;
+    std::cout << "Dispatches: " << profile.dispatches
+              << "  Preemptions: " << profile.preemptions << std::endl;
+    std::cout << "Ready high-water mark: " << profile.readyHighWater
+              << "  Busy CPUs high-water mark: " << profile.runningHighWater << std::endl;
+}
\ No newline at end of file
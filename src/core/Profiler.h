@@ -0,0 +1,67 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <chrono>
+#include <cstddef>
+
+// Phase timers and event counters for the tick loop. Everything here compiles
+// to nothing unless the build defines SCHED_ENABLE_PROFILING, so normal builds
+// pay no clock reads in the hot path.
+#ifdef SCHED_ENABLE_PROFILING
+constexpr bool PROFILING_ENABLED = true;
+#else
+constexpr bool PROFILING_ENABLED = false;
+#endif
+
+enum ProfilePhase {
+    PHASE_ADMIT,        // moving arrivals into the ready queue (updateReadyQueue)
+    PHASE_ASSIGN,       // assignProcessesToCPUs, including the selections below
+    PHASE_SELECT,       // the policy's selectNextProcess
+    PHASE_TICK,         // CPU::tick
+    PHASE_PREEMPT,      // the policy's preempt
+    PHASE_COUNT
+};
+
+struct RunProfile {
+    long long nanoseconds[PHASE_COUNT] = {};
+    long long calls[PHASE_COUNT] = {};
+    
+    long long ticks = 0;
+    long long arrivals = 0;
+    long long completions = 0;
+    long long dispatches = 0;       // processes placed on a CPU, the scheduling decisions
+    long long preemptions = 0;      // running processes taken off a CPU unfinished
+    size_t readyHighWater = 0;      // most processes waiting at once, policy queues included
+    size_t runningHighWater = 0;    // most busy CPUs at once
+};
+
+// Adds the lifetime of the object to one phase of a profile
+class ScopedPhase {
+#ifdef SCHED_ENABLE_PROFILING
+private:
+    RunProfile& profile;
+    ProfilePhase phase;
+    std::chrono::steady_clock::time_point start;
+    
+public:
+    ScopedPhase(RunProfile& target, ProfilePhase timedPhase)
+        : profile(target), phase(timedPhase), start(std::chrono::steady_clock::now()) {}
+    
+    ~ScopedPhase() {
+        profile.nanoseconds[phase] += std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        profile.calls[phase]++;
+    }
+#else
+public:
+    ScopedPhase(RunProfile&, ProfilePhase) {}
+#endif
+};
+
+class Profiler {
+public:
+    static const char* phaseName(ProfilePhase phase);
+    static void print(const RunProfile& profile);
+};
+
+#endif // PROFILER_H
\ No newline at end of file
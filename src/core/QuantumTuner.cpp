@@ -0,0 +1,233 @@
+#include "QuantumTuner.h"
+#include "ResultCache.h"
+#include "../algorithms/RoundRobin.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <thread>
+
+QuantumTuner::QuantumTuner(const std::vector<std::shared_ptr<Process>>& processes, int cpus,
+                           TuningObjective tuningObjective)
+    : workload(std::make_shared<const Workload>(processes)), numCPUs(cpus), objective(tuningObjective),
+      minQuantum(1), maxQuantum(1), threads(1), resultCache(nullptr), simulations(0), cacheHits(0) {
+    for (const auto& process : processes) {
+        maxQuantum = std::max(maxQuantum, process->getBurstTime());
+    }
+    setThreads(static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+void QuantumTuner::setRange(int minimum, int maximum) {
+    minQuantum = std::max(1, minimum);
+    maxQuantum = std::max(minQuantum, maximum);
+}
+
+void QuantumTuner::setThreads(int count) {
+    threads = std::max(1, count);
+}
+
+// Every run keeps its own run state over the shared workload, so runs can go
+// in parallel
+QuantumEvaluation QuantumTuner::simulate(int quantum) const {
+    RoundRobin scheduler(quantum, numCPUs);
+    scheduler.setQuiet(true);
+    
+    QuantumEvaluation evaluation;
+    evaluation.quantum = quantum;
+    std::vector<int> responses;
+    if (resultCache) {
+        SimulationResult result = resultCache->run(scheduler, workload);
+        evaluation.meanResponse = result.avgResponseTime;
+        evaluation.meanTurnaround = result.avgTurnaroundTime;
+        evaluation.contextSwitches = result.contextSwitches;
+        responses = std::move(result.responseTimes);
+    } else {
+        scheduler.setWorkload(workload);
+        scheduler.run();
+        evaluation.meanResponse = scheduler.calculateAverageResponseTime();
+        evaluation.meanTurnaround = scheduler.calculateAverageTurnaroundTime();
+        evaluation.contextSwitches = scheduler.countContextSwitches();
+        
+        const auto& processes = scheduler.getProcesses();
+        responses.reserve(processes.size());
+        for (const auto& process : processes) {
+            responses.push_back(process->getResponseTime());
+        }
+    }
+    
+    // Nearest-rank 99th percentile
+    if (!responses.empty()) {
+        size_t rank = static_cast<size_t>(std::ceil(0.99 * responses.size()));
+        auto nth = responses.begin() + (rank > 0 ? rank - 1 : 0);
+        std::nth_element(responses.begin(), nth, responses.end());
+        evaluation.p99Response = *nth;
+    }
+    
+    switch (objective) {
+        case TUNE_MEAN_RESPONSE: evaluation.objective = evaluation.meanResponse; break;
+        case TUNE_P99_RESPONSE: evaluation.objective = evaluation.p99Response; break;
+        case TUNE_MEAN_TURNAROUND: evaluation.objective = evaluation.meanTurnaround; break;
+        case TUNE_CONTEXT_SWITCHES: evaluation.objective = static_cast<double>(evaluation.contextSwitches); break;
+    }
+    return evaluation;
+}
+
+// Simulates the quanta not cached yet, up to `threads` at a time
+void QuantumTuner::evaluateAll(const std::vector<int>& quanta) {
+    std::vector<int> missing;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        std::set<int> seen;
+        for (int quantum : quanta) {
+            if (cache.count(quantum)) {
+                cacheHits++;
+            } else if (seen.insert(quantum).second) {
+                missing.push_back(quantum);
+            }
+        }
+    }
+    if (missing.empty()) return;
+    
+    std::vector<QuantumEvaluation> results(missing.size());
+    std::atomic<size_t> nextIndex(0);
+    auto worker = [&]() {
+        for (size_t i = nextIndex++; i < missing.size(); i = nextIndex++) {
+            results[i] = simulate(missing[i]);
+        }
+    };
+    
+    // A lone worker runs here: starting a thread would make every shared_ptr
+    // copy in later simulations atomic (see AsyncWriter)
+    size_t workers = std::min(missing.size(), static_cast<size_t>(threads));
+    if (workers <= 1) {
+        worker();
+    } else {
+        std::vector<std::future<void>> running;
+        for (size_t i = 0; i < workers; ++i) {
+            running.push_back(std::async(std::launch::async, worker));
+        }
+        for (auto& future : running) {
+            future.get();
+        }
+    }
+    
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    for (const auto& result : results) {
+        cache[result.quantum] = result;
+    }
+    simulations += static_cast<int>(results.size());
+}
+
+QuantumEvaluation QuantumTuner::evaluate(int quantum) {
+    evaluateAll({quantum});
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return cache[quantum];
+}
+
+// Lower objective wins; on a tie the larger quantum, which switches less
+bool QuantumTuner::better(const QuantumEvaluation& a, const QuantumEvaluation& b) const {
+    if (a.objective != b.objective) return a.objective < b.objective;
+    return a.quantum > b.quantum;
+}
+
+int QuantumTuner::bestCached(int low, int high) const {
+    const QuantumEvaluation* best = nullptr;
+    for (auto it = cache.lower_bound(low); it != cache.end() && it->first <= high; ++it) {
+        if (!best || better(it->second, *best)) {
+            best = &it->second;
+        }
+    }
+    return best ? best->quantum : low;
+}
+
+TuningResult QuantumTuner::tune() {
+    const int simulationsBefore = simulations;
+    const int hitsBefore = cacheHits;
+    
+    // Quantum effects are roughly scale-like, so the coarse grid is geometric
+    const int gridSize = std::max(8, 2 * threads);
+    std::vector<int> grid;
+    double ratio = static_cast<double>(maxQuantum) / minQuantum;
+    for (int i = 0; i < gridSize; ++i) {
+        grid.push_back(static_cast<int>(std::lround(minQuantum * std::pow(ratio, i / (gridSize - 1.0)))));
+    }
+    evaluateAll(grid);
+    
+    // The best point's evaluated neighbours bracket the refinement. Nothing
+    // inside the new bracket is cached yet, so every round adds points and the
+    // bracket keeps shrinking.
+    int low = minQuantum;
+    int high = maxQuantum;
+    while (true) {
+        auto it = cache.find(bestCached(low, high));
+        if (it == cache.end()) break;
+        if (it != cache.begin() && std::prev(it)->first >= low) low = std::prev(it)->first;
+        if (std::next(it) != cache.end() && std::next(it)->first <= high) high = std::next(it)->first;
+        if (high - low <= 2) break;
+        
+        // One new candidate per worker, evenly spread inside the bracket
+        int candidates = std::max(2, threads);
+        std::vector<int> points;
+        for (int j = 1; j <= candidates; ++j) {
+            int point = low + static_cast<int>((static_cast<long long>(high - low) * j) / (candidates + 1));
+            if (point > low && point < high) {
+                points.push_back(point);
+            }
+        }
+        evaluateAll(points);
+    }
+    
+    std::vector<int> remaining;
+    for (int quantum = low; quantum <= high; ++quantum) {
+        remaining.push_back(quantum);
+    }
+    evaluateAll(remaining);
+    
+    TuningResult result;
+    result.bestQuantum = bestCached(minQuantum, maxQuantum);
+    result.bestObjective = cache[result.bestQuantum].objective;
+    for (auto it = cache.lower_bound(minQuantum); it != cache.end() && it->first <= maxQuantum; ++it) {
+        result.curve.push_back(it->second);
+    }
+    result.simulations = simulations - simulationsBefore;
+    result.cacheHits = cacheHits - hitsBefore;
+    return result;
+}
+
+std::string QuantumTuner::objectiveName(TuningObjective objective) {
+    switch (objective) {
+        case TUNE_MEAN_RESPONSE: return "mean response time";
+        case TUNE_P99_RESPONSE: return "p99 response time";
+        case TUNE_MEAN_TURNAROUND: return "mean turnaround time";
+        case TUNE_CONTEXT_SWITCHES: return "context switches";
+    }
+    return "objective";
+}
+
+void QuantumTuner::printResult(const TuningResult& result, TuningObjective objective) {
+    std::cout << "\n=== ROUND ROBIN QUANTUM TUNING (" << objectiveName(objective) << ") ===" << std::endl;
+    std::cout << std::left << std::setw(10) << "Quantum"
+              << std::setw(15) << "Avg Response"
+              << std::setw(15) << "P99 Response"
+              << std::setw(18) << "Avg Turnaround"
+              << std::setw(12) << "Switches" << std::endl;
+    std::cout << std::string(70, '-') << std::endl;
+    
+    for (const auto& point : result.curve) {
+        std::cout << std::left << std::setw(10) << point.quantum
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(15) << point.meanResponse
+                  << std::setw(15) << point.p99Response
+                  << std::setw(18) << point.meanTurnaround
+                  << std::setw(12) << point.contextSwitches
+                  << (point.quantum == result.bestQuantum ? "<- best" : "") << std::endl;
+    }
+    std::cout << std::string(70, '-') << std::endl;
+    std::cout << "Best quantum: " << result.bestQuantum << " (" << objectiveName(objective)
+              << " " << std::fixed << std::setprecision(2) << result.bestObjective << ")" << std::endl;
+    std::cout << "Simulations run: " << result.simulations
+              << " (" << result.cacheHits << " answered from cache)" << std::endl;
+}
\ No newline at end of file
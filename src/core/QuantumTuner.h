@@ -0,0 +1,83 @@
+#ifndef QUANTUMTUNER_H
+#define QUANTUMTUNER_H
+
+#include "../Process.h"
+#include "Workload.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class ResultCache;
+
+// What the tuner minimises
+enum TuningObjective {
+    TUNE_MEAN_RESPONSE,
+    TUNE_P99_RESPONSE,
+    TUNE_MEAN_TURNAROUND,
+    TUNE_CONTEXT_SWITCHES
+};
+
+// One simulated Round Robin run of the workload
+struct QuantumEvaluation {
+    int quantum = 0;
+    double objective = 0.0;
+    double meanResponse = 0.0;
+    double p99Response = 0.0;
+    double meanTurnaround = 0.0;
+    long long contextSwitches = 0;
+};
+
+struct TuningResult {
+    int bestQuantum = 0;
+    double bestObjective = 0.0;
+    std::vector<QuantumEvaluation> curve;   // every quantum evaluated, ascending
+    int simulations = 0;                    // runs actually simulated
+    int cacheHits = 0;                      // evaluations answered from earlier runs
+};
+
+// Picks the Round Robin quantum for a workload by simulating candidates. A
+// geometric grid over [minQuantum, maxQuantum] locates the best region, then a
+// multisection search narrows the bracket around the best point, evaluating
+// one candidate per worker thread per round. Runs are cached by quantum, so
+// points shared between rounds (or repeated tune() calls) cost nothing.
+class QuantumTuner {
+private:
+    std::shared_ptr<const Workload> workload;
+    int numCPUs;
+    TuningObjective objective;
+    int minQuantum;
+    int maxQuantum;
+    int threads;
+    ResultCache* resultCache;
+    
+    std::mutex cacheMutex;
+    std::map<int, QuantumEvaluation> cache;
+    int simulations;
+    int cacheHits;
+    
+    QuantumEvaluation simulate(int quantum) const;
+    void evaluateAll(const std::vector<int>& quanta);
+    int bestCached(int low, int high) const;
+    bool better(const QuantumEvaluation& a, const QuantumEvaluation& b) const;
+    
+public:
+    QuantumTuner(const std::vector<std::shared_ptr<Process>>& processes, int numCPUs,
+                 TuningObjective objective = TUNE_MEAN_RESPONSE);
+    
+    // Defaults to [1, longest burst]; beyond that Round Robin behaves like FCFS
+    void setRange(int minimum, int maximum);
+    void setThreads(int count);
+    
+    // Runs stored on disk by earlier tunings are reused instead of simulated
+    void setResultCache(ResultCache* cache) { resultCache = cache; }
+    
+    QuantumEvaluation evaluate(int quantum);
+    TuningResult tune();
+    
+    static std::string objectiveName(TuningObjective objective);
+    static void printResult(const TuningResult& result, TuningObjective objective);
+};
+
+#endif // QUANTUMTUNER_H
\ No newline at end of file
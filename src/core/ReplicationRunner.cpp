@@ -0,0 +1,189 @@
+#include "ReplicationRunner.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <future>
+#include <stdexcept>
+#include <thread>
+
+void RunningStatistic::add(double value) {
+    n++;
+    double delta = value - mean;
+    mean += delta / n;
+    m2 += delta * (value - mean);
+}
+
+double RunningStatistic::standardError() const {
+    return n > 1 ? std::sqrt(variance() / n) : 0.0;
+}
+
+double RunningStatistic::halfWidth(double confidence) const {
+    return n > 1 ? ReplicationRunner::criticalValue(confidence, n - 1) * standardError() : 0.0;
+}
+
+ReplicationRunner::ReplicationRunner(const WorkloadSpec& workload)
+    : spec(workload), minReplications(5), maxReplications(100), batchSize(8),
+      confidence(0.95), targetPrecision(0.0), targetMetric(METRIC_WAITING), threads(1) {
+    setThreads(static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+void ReplicationRunner::addConfiguration(const std::string& name, SchedulerFactory factory) {
+    names.push_back(name);
+    factories.push_back(factory);
+}
+
+void ReplicationRunner::setReplications(int minimum, int maximum) {
+    minReplications = std::max(2, minimum);
+    maxReplications = std::max(minReplications, maximum);
+}
+
+void ReplicationRunner::setPrecision(double relativeHalfWidth, ReplicationMetric metric) {
+    targetPrecision = std::max(0.0, relativeHalfWidth);
+    targetMetric = metric;
+}
+
+void ReplicationRunner::setConfidence(double level) {
+    if (level <= 0.0 || level >= 1.0) {
+        throw std::invalid_argument("Confidence level must be between 0 and 1");
+    }
+    confidence = level;
+}
+
+void ReplicationRunner::setThreads(int count) {
+    threads = std::max(1, count);
+}
+
+// Every configuration of one replication, on that replication's workload;
+// returns the metrics configuration by configuration
+std::vector<double> ReplicationRunner::replicate(int replication) const {
+    // Seeds are drawn from the base seed rather than counted up from it, so
+    // experiments with neighbouring seeds do not share replications
+    uint32_t words[4];
+    Philox4x32(spec.seed).generate(static_cast<uint64_t>(replication), 0, words);
+    WorkloadSpec replicationSpec = spec;
+    replicationSpec.seed = (static_cast<uint64_t>(words[1]) << 32) | words[0];
+    replicationSpec.threads = 1;
+    auto workload = std::make_shared<const Workload>(WorkloadGenerator::generate(replicationSpec));
+    
+    std::vector<double> values;
+    values.reserve(factories.size() * METRIC_COUNT);
+    for (const auto& factory : factories) {
+        auto scheduler = factory();
+        scheduler->setQuiet(true);
+        scheduler->setWorkload(workload);
+        scheduler->run();
+        
+        values.push_back(scheduler->calculateAverageWaitingTime());
+        values.push_back(scheduler->calculateAverageTurnaroundTime());
+        values.push_back(scheduler->calculateAverageResponseTime());
+        values.push_back(scheduler->calculateAverageCPUUtilization());
+    }
+    return values;
+}
+
+ReplicationResult ReplicationRunner::run() {
+    if (factories.empty()) {
+        throw std::invalid_argument("No configurations to replicate");
+    }
+    
+    ReplicationResult result;
+    result.targetMetric = targetMetric;
+    result.confidence = confidence;
+    result.targetPrecision = targetPrecision;
+    result.configurations.resize(factories.size());
+    for (size_t c = 0; c < factories.size(); ++c) {
+        result.configurations[c].name = names[c];
+    }
+    std::vector<std::vector<double>> targetValues(factories.size());
+    
+    while (result.replications < maxReplications) {
+        int batch = std::min(batchSize, maxReplications - result.replications);
+        std::vector<std::vector<double>> outcomes(batch);
+        std::atomic<int> nextIndex(0);
+        auto worker = [&]() {
+            for (int i = nextIndex++; i < batch; i = nextIndex++) {
+                outcomes[i] = replicate(result.replications + i);
+            }
+        };
+        
+        // As in QuantumTuner, a lone worker runs here so single-threaded runs
+        // keep non-atomic shared_ptr copies
+        int workers = std::min(batch, threads);
+        if (workers <= 1) {
+            worker();
+        } else {
+            std::vector<std::future<void>> running;
+            for (int i = 0; i < workers; ++i) {
+                running.push_back(std::async(std::launch::async, worker));
+            }
+            for (auto& future : running) {
+                future.get();
+            }
+        }
+        
+        // Folded in replication order, so sums do not depend on scheduling
+        for (const auto& values : outcomes) {
+            for (size_t c = 0; c < factories.size(); ++c) {
+                for (int m = 0; m < METRIC_COUNT; ++m) {
+                    result.configurations[c].metrics[m].add(values[c * METRIC_COUNT + m]);
+                }
+                targetValues[c].push_back(values[c * METRIC_COUNT + targetMetric]);
+            }
+        }
+        result.replications += batch;
+        
+        if (result.replications >= minReplications && targetPrecision > 0.0) {
+            bool precise = true;
+            for (const auto& configuration : result.configurations) {
+                const RunningStatistic& metric = configuration.metrics[targetMetric];
+                precise = precise && metric.halfWidth(confidence) <= targetPrecision * std::fabs(metric.getMean());
+            }
+            if (precise) {
+                result.converged = true;
+                break;
+            }
+        }
+    }
+    
+    // Higher utilization is better; lower is better for every time metric
+    for (size_t c = 1; c < result.configurations.size(); ++c) {
+        double mean = result.configurations[c].metrics[targetMetric].getMean();
+        double best = result.configurations[result.bestConfiguration].metrics[targetMetric].getMean();
+        if (targetMetric == METRIC_UTILIZATION ? mean > best : mean < best) {
+            result.bestConfiguration = c;
+        }
+    }
+    for (size_t c = 0; c < result.configurations.size(); ++c) {
+        for (int r = 0; r < result.replications; ++r) {
+            result.configurations[c].differenceFromBest.add(
+                targetValues[c][r] - targetValues[result.bestConfiguration][r]);
+        }
+    }
+    return result;
+}
+
+double ReplicationRunner::criticalValue(double confidence, long long degreesOfFreedom) {
+    const double pi = 3.141592653589793;
+    double p = (1.0 + confidence) / 2.0;
+    double nu = static_cast<double>(degreesOfFreedom);
+    
+    // Closed forms where the expansion is poor
+    if (degreesOfFreedom <= 1) return std::tan(pi * (p - 0.5));
+    if (degreesOfFreedom == 2) return (2.0 * p - 1.0) / std::sqrt(2.0 * p * (1.0 - p));
+    
+    double z = WorkloadGenerator::normalQuantile(p);
+    double z3 = z * z * z, z5 = z3 * z * z, z7 = z5 * z * z;
+    return z + (z3 + z) / (4.0 * nu)
+             + (5.0 * z5 + 16.0 * z3 + 3.0 * z) / (96.0 * nu * nu)
+             + (3.0 * z7 + 19.0 * z5 + 17.0 * z3 - 15.0 * z) / (384.0 * nu * nu * nu);
+}
+
+std::string ReplicationRunner::metricName(ReplicationMetric metric) {
+    switch (metric) {
+        case METRIC_WAITING: return "waiting time";
+        case METRIC_TURNAROUND: return "turnaround time";
+        case METRIC_RESPONSE: return "response time";
+        case METRIC_UTILIZATION: return "CPU utilization";
+        default: return "metric";
+    }
+}
\ No newline at end of file
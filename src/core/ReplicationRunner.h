@@ -0,0 +1,104 @@
+#ifndef REPLICATIONRUNNER_H
+#define REPLICATIONRUNNER_H
+
+#include "../Scheduler.h"
+#include "../utils/WorkloadGenerator.h"
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+enum ReplicationMetric {
+    METRIC_WAITING,
+    METRIC_TURNAROUND,
+    METRIC_RESPONSE,
+    METRIC_UTILIZATION,
+    METRIC_COUNT
+};
+
+// Mean and variance of a sample, updated one value at a time (Welford), so
+// long runs neither keep the values nor lose precision to cancellation
+class RunningStatistic {
+private:
+    long long n;
+    double mean;
+    double m2;
+    
+public:
+    RunningStatistic() : n(0), mean(0.0), m2(0.0) {}
+    
+    void add(double value);
+    long long count() const { return n; }
+    double getMean() const { return mean; }
+    double variance() const { return n > 1 ? m2 / (n - 1) : 0.0; }
+    double standardError() const;
+    
+    // Half-width of the Student t confidence interval for the mean
+    double halfWidth(double confidence) const;
+};
+
+struct ReplicationSummary {
+    std::string name;
+    RunningStatistic metrics[METRIC_COUNT];
+    
+    // Paired difference from the best configuration on the target metric,
+    // replication by replication; every configuration sees the same workloads
+    RunningStatistic differenceFromBest;
+};
+
+struct ReplicationResult {
+    std::vector<ReplicationSummary> configurations;
+    ReplicationMetric targetMetric = METRIC_WAITING;
+    double confidence = 0.95;
+    double targetPrecision = 0.0;
+    int replications = 0;
+    size_t bestConfiguration = 0;
+    bool converged = false;             // stopped because the precision was reached
+};
+
+// Runs every configuration on N independently seeded workloads and aggregates
+// each metric with its mean, standard error and confidence interval.
+// Replications run in batches spread over worker threads; after each batch the
+// runner stops once every configuration's target metric has a confidence
+// interval narrower than targetPrecision times its mean. Replication r always
+// gets the same seed and batches are fixed-size, so results do not depend on
+// the thread count.
+class ReplicationRunner {
+public:
+    typedef std::function<std::unique_ptr<Scheduler>()> SchedulerFactory;
+    
+private:
+    WorkloadSpec spec;
+    std::vector<std::string> names;
+    std::vector<SchedulerFactory> factories;
+    int minReplications;
+    int maxReplications;
+    int batchSize;
+    double confidence;
+    double targetPrecision;
+    ReplicationMetric targetMetric;
+    int threads;
+    
+    std::vector<double> replicate(int replication) const;
+    
+public:
+    explicit ReplicationRunner(const WorkloadSpec& workload);
+    
+    void addConfiguration(const std::string& name, SchedulerFactory factory);
+    void setReplications(int minimum, int maximum);
+    
+    // Relative half-width to stop at, e.g. 0.02 for +/-2% of the mean; 0 runs
+    // the maximum number of replications
+    void setPrecision(double relativeHalfWidth, ReplicationMetric metric = METRIC_WAITING);
+    void setConfidence(double level);
+    void setThreads(int count);
+    
+    ReplicationResult run();
+    
+    // Two-sided Student t critical value (Cornish-Fisher expansion around the
+    // normal quantile; within 1% of the exact value from 3 degrees of freedom)
+    static double criticalValue(double confidence, long long degreesOfFreedom);
+    static std::string metricName(ReplicationMetric metric);
+};
+
+#endif // REPLICATIONRUNNER_H
\ No newline at end of file
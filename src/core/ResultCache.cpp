@@ -0,0 +1,180 @@
+#include "ResultCache.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+// FNV-1a over the value's bytes, least significant first
+static void hashValue(uint64_t& hash, long long value) {
+    for (int i = 0; i < 8; ++i) {
+        hash ^= static_cast<uint64_t>(value >> (8 * i)) & 0xff;
+        hash *= 1099511628211ULL;
+    }
+}
+
+static void hashString(uint64_t& hash, const std::string& text) {
+    hashValue(hash, static_cast<long long>(text.size()));
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+}
+
+SimulationResult SimulationResult::fromScheduler(const Scheduler& scheduler) {
+    SimulationResult result;
+    result.algorithm = scheduler.getAlgorithmName();
+    result.endTime = scheduler.getCurrentTime();
+    result.contextSwitches = scheduler.countContextSwitches();
+    result.avgWaitingTime = scheduler.calculateAverageWaitingTime();
+    result.avgTurnaroundTime = scheduler.calculateAverageTurnaroundTime();
+    result.avgResponseTime = scheduler.calculateAverageResponseTime();
+    result.cpuUtilization = scheduler.calculateAverageCPUUtilization();
+    result.throughput = scheduler.calculateThroughput();
+    
+    const auto& processes = scheduler.getProcesses();
+    for (auto* column : {&result.processIDs, &result.priorities, &result.burstTimes, &result.waitingTimes,
+                         &result.turnaroundTimes, &result.responseTimes, &result.completionTimes}) {
+        column->reserve(processes.size());
+    }
+    for (const auto& process : processes) {
+        result.processIDs.push_back(process->getProcessID());
+        result.priorities.push_back(process->getPriority());
+        result.burstTimes.push_back(process->getBurstTime());
+        result.waitingTimes.push_back(process->getWaitingTime());
+        result.turnaroundTimes.push_back(process->getTurnaroundTime());
+        result.responseTimes.push_back(process->getResponseTime());
+        result.completionTimes.push_back(process->getCompletionTime());
+    }
+    return result;
+}
+
+ResultCache::ResultCache(const std::string& cacheDirectory)
+    : directory(cacheDirectory), hits(0), misses(0) {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (!std::filesystem::is_directory(directory)) {
+        throw std::runtime_error("Could not create cache directory " + directory);
+    }
+}
+
+uint64_t ResultCache::hashWorkload(const Workload& workload) {
+    uint64_t hash = 14695981039346656037ULL;
+    hashValue(hash, static_cast<long long>(workload.size()));
+    for (const Process& process : workload.getProcesses()) {
+        hashValue(hash, process.getProcessID());
+        hashValue(hash, process.getArrivalTime());
+        hashValue(hash, process.getBurstTime());
+        hashValue(hash, process.getPriority());
+        hashValue(hash, process.getWidth());
+        if (!process.getGroup().empty()) {
+            hashString(hash, process.getGroup());   // ungrouped workloads keep their earlier hashes
+        }
+    }
+    return hash;
+}
+
+uint64_t ResultCache::hashText(const std::string& text) {
+    uint64_t hash = 14695981039346656037ULL;
+    hashString(hash, text);
+    return hash;
+}
+
+std::string ResultCache::pathFor(const std::string& setup, uint64_t workloadHash) const {
+    uint64_t hash = 14695981039346656037ULL;
+    hashValue(hash, SIMULATOR_VERSION);
+    hashString(hash, setup);
+    hashValue(hash, static_cast<long long>(workloadHash));
+    
+    std::ostringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0') << hash << ".result";
+    return (std::filesystem::path(directory) / name.str()).string();
+}
+
+// Header lines, then one line of summary values and one line per process
+bool ResultCache::load(const std::string& path, const std::string& setup, uint64_t workloadHash,
+                       SimulationResult& result) const {
+    std::ifstream file(path);
+    if (!file.is_open()) return false;
+    
+    std::string line;
+    std::string expectedVersion = "# scheduler result, simulator version " + std::to_string(SIMULATOR_VERSION);
+    if (!std::getline(file, line) || line != expectedVersion) return false;
+    if (!std::getline(file, line) || line != setup) return false;
+    uint64_t storedHash = 0;
+    size_t rows = 0;
+    if (!(file >> std::hex >> storedHash >> std::dec >> rows) || storedHash != workloadHash) return false;
+    
+    SimulationResult loaded;
+    file >> std::ws;
+    if (!std::getline(file, loaded.algorithm)) return false;
+    file >> loaded.endTime >> loaded.contextSwitches >> loaded.avgWaitingTime >> loaded.avgTurnaroundTime
+         >> loaded.avgResponseTime >> loaded.cpuUtilization >> loaded.throughput;
+    for (auto* column : {&loaded.processIDs, &loaded.priorities, &loaded.burstTimes, &loaded.waitingTimes,
+                         &loaded.turnaroundTimes, &loaded.responseTimes, &loaded.completionTimes}) {
+        column->resize(rows);
+    }
+    for (size_t i = 0; i < rows; ++i) {
+        file >> loaded.processIDs[i] >> loaded.priorities[i] >> loaded.burstTimes[i] >> loaded.waitingTimes[i]
+             >> loaded.turnaroundTimes[i] >> loaded.responseTimes[i] >> loaded.completionTimes[i];
+    }
+    if (!file) return false;
+    
+    result = std::move(loaded);
+    return true;
+}
+
+void ResultCache::store(const std::string& path, const std::string& setup, uint64_t workloadHash,
+                        const SimulationResult& result) const {
+    std::ostringstream suffix;
+    suffix << ".tmp" << std::this_thread::get_id();
+    std::string temporary = path + suffix.str();
+    {
+        std::ofstream file(temporary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not open file " + temporary);
+        }
+        file << "# scheduler result, simulator version " << SIMULATOR_VERSION << "\n"
+             << setup << "\n"
+             << std::hex << workloadHash << std::dec << " " << result.processIDs.size() << "\n"
+             << result.algorithm << "\n"
+             << std::setprecision(17) << result.endTime << " " << result.contextSwitches << " "
+             << result.avgWaitingTime << " " << result.avgTurnaroundTime << " " << result.avgResponseTime << " "
+             << result.cpuUtilization << " " << result.throughput << "\n";
+        for (size_t i = 0; i < result.processIDs.size(); ++i) {
+            file << result.processIDs[i] << " " << result.priorities[i] << " " << result.burstTimes[i] << " "
+                 << result.waitingTimes[i] << " " << result.turnaroundTimes[i] << " "
+                 << result.responseTimes[i] << " " << result.completionTimes[i] << "\n";
+        }
+        if (!file) {
+            throw std::runtime_error("Could not write file " + temporary);
+        }
+    }
+    
+    // Another run may have stored the same result meanwhile; either copy will do
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+        std::filesystem::remove(temporary, error);
+    }
+}
+
+SimulationResult ResultCache::run(Scheduler& scheduler, std::shared_ptr<const Workload> workload) {
+    std::string setup = scheduler.describeSetup();
+    uint64_t workloadHash = hashWorkload(*workload);
+    std::string path = pathFor(setup, workloadHash);
+    
+    SimulationResult result;
+    if (load(path, setup, workloadHash, result)) {
+        hits++;
+        return result;
+    }
+    misses++;
+    scheduler.setWorkload(std::move(workload));
+    scheduler.run();
+    result = SimulationResult::fromScheduler(scheduler);
+    store(path, setup, workloadHash, result);
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#ifndef RESULTCACHE_H
+#define RESULTCACHE_H
+
+#include "../Scheduler.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Bumped whenever a change to the simulator alters the results of a run, so
+// results cached by earlier versions are never served
+constexpr int SIMULATOR_VERSION = 1;
+
+// What a finished run reports: the summary statistics and each process's
+// results, in the scheduler's process order
+struct SimulationResult {
+    std::string algorithm;
+    int endTime = 0;
+    long long contextSwitches = 0;
+    double avgWaitingTime = 0.0;
+    double avgTurnaroundTime = 0.0;
+    double avgResponseTime = 0.0;
+    double cpuUtilization = 0.0;
+    double throughput = 0.0;
+    
+    std::vector<int> processIDs;
+    std::vector<int> priorities;
+    std::vector<int> burstTimes;
+    std::vector<int> waitingTimes;
+    std::vector<int> turnaroundTimes;
+    std::vector<int> responseTimes;
+    std::vector<int> completionTimes;
+    
+    static SimulationResult fromScheduler(const Scheduler& scheduler);
+};
+
+// Results of earlier runs kept on disk, one file per run, named by a hash of
+// the workload (every process's ID, arrival, burst, priority and width, in
+// order), the scheduler's setup and SIMULATOR_VERSION. Each file repeats the
+// setup and the workload hash, and a file that does not match is treated as
+// a miss. Files are written under a temporary name and renamed, so
+// concurrent runs sharing a directory never read half a file.
+class ResultCache {
+private:
+    std::string directory;
+    std::atomic<long long> hits;
+    std::atomic<long long> misses;
+    
+    std::string pathFor(const std::string& setup, uint64_t workloadHash) const;
+    bool load(const std::string& path, const std::string& setup, uint64_t workloadHash,
+              SimulationResult& result) const;
+    void store(const std::string& path, const std::string& setup, uint64_t workloadHash,
+               const SimulationResult& result) const;
+    
+public:
+    explicit ResultCache(const std::string& cacheDirectory);
+    
+    // The cached result of this scheduler's setup on the workload; on a miss
+    // the scheduler runs the workload and the result is stored. Safe to call
+    // from several threads with different schedulers.
+    SimulationResult run(Scheduler& scheduler, std::shared_ptr<const Workload> workload);
+    
+    long long getHits() const { return hits; }
+    long long getMisses() const { return misses; }
+    
+    static uint64_t hashWorkload(const Workload& workload);
+    static uint64_t hashText(const std::string& text);
+};
+
+#endif // RESULTCACHE_H
\ No newline at end of file
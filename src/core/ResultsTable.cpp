@@ -0,0 +1,235 @@
+#include "ResultsTable.h"
+#include "ResultCache.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+int ResultsTable::encode(std::vector<std::string>& dictionary, const std::string& value) {
+    // Dictionaries hold a handful of algorithm/config names; a scan is cheapest
+    for (size_t i = 0; i < dictionary.size(); ++i) {
+        if (dictionary[i] == value) return static_cast<int>(i);
+    }
+    dictionary.push_back(value);
+    return static_cast<int>(dictionary.size() - 1);
+}
+
+void ResultsTable::reserve(size_t rows) {
+    for (auto* col : {&processIDs, &algorithmCodes, &configCodes, &runCodes, &priorities, &burstTimes,
+                      &waitingTimes, &turnaroundTimes, &responseTimes, &completionTimes}) {
+        col->reserve(rows);
+    }
+}
+
+void ResultsTable::clear() {
+    for (auto* col : {&processIDs, &algorithmCodes, &configCodes, &runCodes, &priorities, &burstTimes,
+                      &waitingTimes, &turnaroundTimes, &responseTimes, &completionTimes}) {
+        col->clear();
+    }
+    algorithmNames.clear();
+    configNames.clear();
+    runNames.clear();
+}
+
+void ResultsTable::appendRow(int processID, const std::string& algorithm, const std::string& config,
+                             int priority, int burst, int waiting, int turnaround, int response,
+                             int completion) {
+    int algorithmCode = encode(algorithmNames, algorithm);
+    int configCode = encode(configNames, config);
+    if (runCodes.empty() || algorithmCodes.back() != algorithmCode || configCodes.back() != configCode) {
+        runNames.push_back(algorithm);
+    }
+    processIDs.push_back(processID);
+    algorithmCodes.push_back(algorithmCode);
+    configCodes.push_back(configCode);
+    runCodes.push_back(static_cast<int>(runNames.size() - 1));
+    priorities.push_back(priority);
+    burstTimes.push_back(burst);
+    waitingTimes.push_back(waiting);
+    turnaroundTimes.push_back(turnaround);
+    responseTimes.push_back(response);
+    completionTimes.push_back(completion);
+}
+
+void ResultsTable::appendRun(const Scheduler& scheduler, const std::string& config) {
+    const auto& processes = scheduler.getProcesses();
+    reserve(size() + processes.size());
+    
+    int algorithmCode = encode(algorithmNames, scheduler.getAlgorithmName());
+    int configCode = encode(configNames, config);
+    int runCode = static_cast<int>(runNames.size());
+    runNames.push_back(scheduler.getAlgorithmName());
+    for (const auto& process : processes) {
+        processIDs.push_back(process->getProcessID());
+        algorithmCodes.push_back(algorithmCode);
+        configCodes.push_back(configCode);
+        runCodes.push_back(runCode);
+        priorities.push_back(process->getPriority());
+        burstTimes.push_back(process->getBurstTime());
+        waitingTimes.push_back(process->getWaitingTime());
+        turnaroundTimes.push_back(process->getTurnaroundTime());
+        responseTimes.push_back(process->getResponseTime());
+        completionTimes.push_back(process->getCompletionTime());
+    }
+}
+
+void ResultsTable::appendResult(const SimulationResult& result, const std::string& config) {
+    reserve(size() + result.processIDs.size());
+    
+    int algorithmCode = encode(algorithmNames, result.algorithm);
+    int configCode = encode(configNames, config);
+    processIDs.insert(processIDs.end(), result.processIDs.begin(), result.processIDs.end());
+    algorithmCodes.insert(algorithmCodes.end(), result.processIDs.size(), algorithmCode);
+    configCodes.insert(configCodes.end(), result.processIDs.size(), configCode);
+    runCodes.insert(runCodes.end(), result.processIDs.size(), static_cast<int>(runNames.size()));
+    runNames.push_back(result.algorithm);
+    priorities.insert(priorities.end(), result.priorities.begin(), result.priorities.end());
+    burstTimes.insert(burstTimes.end(), result.burstTimes.begin(), result.burstTimes.end());
+    waitingTimes.insert(waitingTimes.end(), result.waitingTimes.begin(), result.waitingTimes.end());
+    turnaroundTimes.insert(turnaroundTimes.end(), result.turnaroundTimes.begin(), result.turnaroundTimes.end());
+    responseTimes.insert(responseTimes.end(), result.responseTimes.begin(), result.responseTimes.end());
+    completionTimes.insert(completionTimes.end(), result.completionTimes.begin(), result.completionTimes.end());
+}
+
+const std::vector<int>& ResultsTable::column(ResultColumn col) const {
+    switch (col) {
+        case COL_WAITING: return waitingTimes;
+        case COL_TURNAROUND: return turnaroundTimes;
+        case COL_RESPONSE: return responseTimes;
+        case COL_COMPLETION: return completionTimes;
+    }
+    throw std::invalid_argument("Unknown result column");
+}
+
+ColumnSummary ResultsTable::summarize(ResultColumn col) const {
+    const std::vector<int>& values = column(col);
+    const int* data = values.data();
+    const size_t n = values.size();
+    
+    ColumnSummary summary;
+    if (n == 0) return summary;
+    
+    // Independent reductions over a contiguous int array: no branches in the
+    // loop body, so each one compiles to packed adds / mins / maxes
+    long long sum = 0;
+    int lo = std::numeric_limits<int>::max();
+    int hi = std::numeric_limits<int>::min();
+    for (size_t i = 0; i < n; ++i) {
+        sum += data[i];
+    }
+    for (size_t i = 0; i < n; ++i) {
+        lo = data[i] < lo ? data[i] : lo;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        hi = data[i] > hi ? data[i] : hi;
+    }
+    
+    summary.count = static_cast<long long>(n);
+    summary.sum = static_cast<double>(sum);
+    summary.mean = summary.sum / n;
+    summary.min = lo;
+    summary.max = hi;
+    return summary;
+}
+
+// Dense group code per row plus a label per code
+void ResultsTable::groupCodes(GroupKey key, std::vector<int>& codes,
+                              std::vector<std::string>& labels) const {
+    const size_t n = size();
+    codes.resize(n);
+    labels.clear();
+    
+    switch (key) {
+        case GROUP_NONE:
+            std::fill(codes.begin(), codes.end(), 0);
+            labels.push_back("All");
+            break;
+        case GROUP_BY_ALGORITHM:
+            codes = algorithmCodes;
+            labels = algorithmNames;
+            break;
+        case GROUP_BY_CONFIG:
+            codes = configCodes;
+            labels = configNames;
+            break;
+        case GROUP_BY_RUN:
+            codes = runCodes;
+            labels = runNames;
+            break;
+        case GROUP_BY_PRIORITY: {
+            // Only priorities that occur get a code, so sparse values stay cheap
+            std::vector<int> distinct(priorities);
+            std::sort(distinct.begin(), distinct.end());
+            distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+            for (size_t i = 0; i < n; ++i) {
+                codes[i] = static_cast<int>(std::lower_bound(distinct.begin(), distinct.end(),
+                                                             priorities[i]) - distinct.begin());
+            }
+            for (int p : distinct) {
+                labels.push_back("Priority " + std::to_string(p));
+            }
+            break;
+        }
+        case GROUP_BY_BURST_BUCKET: {
+            int maxBucket = 0;
+            for (size_t i = 0; i < n; ++i) {
+                int bucket = 0;
+                for (int b = burstTimes[i]; b > 1; b >>= 1) ++bucket;
+                codes[i] = bucket;
+                maxBucket = std::max(maxBucket, bucket);
+            }
+            for (int b = 0; b <= maxBucket && n > 0; ++b) {
+                int lo = 1 << b;
+                labels.push_back(b == 0 ? "Burst 1" :
+                                 "Burst " + std::to_string(lo) + "-" + std::to_string(2 * lo - 1));
+            }
+            break;
+        }
+    }
+}
+
+std::vector<GroupSummary> ResultsTable::groupBy(GroupKey primary, GroupKey secondary) const {
+    std::vector<int> primaryCodes, secondaryCodes;
+    std::vector<std::string> primaryLabels, secondaryLabels;
+    groupCodes(primary, primaryCodes, primaryLabels);
+    groupCodes(secondary, secondaryCodes, secondaryLabels);
+    
+    const size_t n = size();
+    const size_t width = std::max<size_t>(secondaryLabels.size(), 1);
+    const size_t groups = primaryLabels.size() * width;
+    
+    std::vector<long long> counts(groups, 0), waiting(groups, 0), turnaround(groups, 0),
+                           response(groups, 0);
+    std::vector<int> maxCompletion(groups, 0);
+    
+    // Single pass, one accumulator slot per group
+    for (size_t i = 0; i < n; ++i) {
+        size_t g = static_cast<size_t>(primaryCodes[i]) * width + secondaryCodes[i];
+        counts[g]++;
+        waiting[g] += waitingTimes[i];
+        turnaround[g] += turnaroundTimes[i];
+        response[g] += responseTimes[i];
+        maxCompletion[g] = std::max(maxCompletion[g], completionTimes[i]);
+    }
+    
+    // Runs keep their row even without processes, so it lines up with
+    // per-run figures such as CPU utilization
+    bool keepEmpty = primary == GROUP_BY_RUN && secondary == GROUP_NONE;
+    std::vector<GroupSummary> result;
+    for (size_t g = 0; g < groups; ++g) {
+        if (counts[g] == 0 && !keepEmpty) continue;
+        GroupSummary summary;
+        summary.label = primaryLabels[g / width];
+        if (secondary != GROUP_NONE) {
+            summary.label += " / " + secondaryLabels[g % width];
+        }
+        summary.count = counts[g];
+        if (counts[g] > 0) {
+            summary.avgWaitingTime = (double)waiting[g] / counts[g];
+            summary.avgTurnaroundTime = (double)turnaround[g] / counts[g];
+            summary.avgResponseTime = (double)response[g] / counts[g];
+        }
+        summary.maxCompletionTime = maxCompletion[g];
+        result.push_back(summary);
+    }
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#ifndef RESULTSTABLE_H
+#define RESULTSTABLE_H
+
+#include "../Scheduler.h"
+#include <vector>
+#include <string>
+
+struct SimulationResult;
+
+enum ResultColumn {
+    COL_WAITING,
+    COL_TURNAROUND,
+    COL_RESPONSE,
+    COL_COMPLETION
+};
+
+enum GroupKey {
+    GROUP_NONE,
+    GROUP_BY_ALGORITHM,
+    GROUP_BY_CONFIG,
+    GROUP_BY_RUN,           // one group per appended run, labelled with its algorithm, empty runs included
+    GROUP_BY_PRIORITY,
+    GROUP_BY_BURST_BUCKET   // power-of-two burst sizes: 1, 2-3, 4-7, ...
+};
+
+struct ColumnSummary {
+    long long count = 0;
+    double sum = 0.0;
+    double mean = 0.0;
+    int min = 0;
+    int max = 0;
+};
+
+struct GroupSummary {
+    std::string label;
+    long long count = 0;
+    double avgWaitingTime = 0.0;
+    double avgTurnaroundTime = 0.0;
+    double avgResponseTime = 0.0;
+    int maxCompletionTime = 0;
+};
+
+// Per-process results of many runs stored column by column. Strings are
+// dictionary-encoded so every column is a flat int array that the aggregation
+// loops below can stream through (and the compiler can vectorise).
+class ResultsTable {
+private:
+    std::vector<int> processIDs;
+    std::vector<int> algorithmCodes;
+    std::vector<int> configCodes;
+    std::vector<int> runCodes;
+    std::vector<int> priorities;
+    std::vector<int> burstTimes;
+    std::vector<int> waitingTimes;
+    std::vector<int> turnaroundTimes;
+    std::vector<int> responseTimes;
+    std::vector<int> completionTimes;
+    std::vector<std::string> algorithmNames;
+    std::vector<std::string> configNames;
+    std::vector<std::string> runNames;      // algorithm of each run
+    
+    static int encode(std::vector<std::string>& dictionary, const std::string& value);
+    void groupCodes(GroupKey key, std::vector<int>& codes, std::vector<std::string>& labels) const;
+    
+public:
+    void reserve(size_t rows);
+    void clear();
+    
+    // Consecutive rows with the same algorithm and config form one run
+    void appendRow(int processID, const std::string& algorithm, const std::string& config,
+                   int priority, int burst, int waiting, int turnaround, int response, int completion);
+    void appendRun(const Scheduler& scheduler, const std::string& config = "");
+    void appendResult(const SimulationResult& result, const std::string& config = "");
+    
+    size_t size() const { return processIDs.size(); }
+    const std::vector<int>& column(ResultColumn col) const;
+    const std::vector<int>& getProcessIDs() const { return processIDs; }
+    const std::vector<int>& getPriorities() const { return priorities; }
+    const std::vector<int>& getBurstTimes() const { return burstTimes; }
+    const std::string& getAlgorithm(size_t row) const { return algorithmNames[algorithmCodes[row]]; }
+    const std::string& getConfig(size_t row) const { return configNames[configCodes[row]]; }
+    
+    // Whole-column aggregation
+    ColumnSummary summarize(ResultColumn col) const;
+    
+    // Aggregation per group, optionally nested one level (e.g. algorithm x priority)
+    std::vector<GroupSummary> groupBy(GroupKey primary, GroupKey secondary = GROUP_NONE) const;
+};
+
+#endif // RESULTSTABLE_H
\ No newline at end of file
@@ -0,0 +1,88 @@
+#ifndef RUNQUEUES_H
+#define RUNQUEUES_H
+
+#include <algorithm>
+#include <queue>
+#include <utility>
+#include <vector>
+
+// FIFO over a power-of-two ring buffer. std::queue's deque allocates and frees
+// blocks as elements cycle through it; this storage only ever grows, so a
+// queue reserved for a run's peak never allocates during the run.
+template <typename T>
+class RingQueue {
+private:
+    std::vector<T> slots;
+    size_t head;
+    size_t count;
+    
+    size_t wrap(size_t index) const { return index & (slots.size() - 1); }
+    
+    void grow(size_t minimum) {
+        size_t capacity = std::max<size_t>(16, slots.size());
+        while (capacity < minimum) capacity *= 2;
+        if (capacity == slots.size()) return;
+        
+        std::vector<T> bigger(capacity);
+        for (size_t i = 0; i < count; ++i) {
+            bigger[i] = std::move(slots[wrap(head + i)]);
+        }
+        slots.swap(bigger);
+        head = 0;
+    }
+    
+public:
+    RingQueue() : head(0), count(0) {}
+    
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+    void reserve(size_t capacity) { if (capacity > slots.size()) grow(capacity); }
+    
+    T& front() { return slots[head]; }
+    const T& front() const { return slots[head]; }
+    T& operator[](size_t index) { return slots[wrap(head + index)]; }
+    const T& operator[](size_t index) const { return slots[wrap(head + index)]; }
+    
+    void push(const T& value) {
+        if (count == slots.size()) grow(count + 1);
+        slots[wrap(head + count)] = value;
+        count++;
+    }
+    
+    // Vacated slots are reset so they do not keep shared_ptr owners alive
+    void pop() {
+        slots[head] = T();
+        head = wrap(head + 1);
+        count--;
+    }
+    
+    // Removes the element at `index` (0 = front), keeping the order of the rest
+    void eraseAt(size_t index) {
+        for (size_t i = index; i + 1 < count; ++i) {
+            (*this)[i] = std::move((*this)[i + 1]);
+        }
+        (*this)[count - 1] = T();
+        count--;
+    }
+    
+    void clear() {
+        while (!empty()) pop();
+        head = 0;
+    }
+};
+
+// priority_queue whose backing vector can be reserved up front and emptied
+// without giving its storage back
+template <typename T, typename Compare>
+class ReservedHeap : public std::priority_queue<T, std::vector<T>, Compare> {
+public:
+    void reserve(size_t capacity) { this->c.reserve(capacity); }
+    void clear() { this->c.clear(); }
+    
+    // The heap's storage in heap order, and its replacement by storage saved
+    // that way, e.g. for a checkpoint
+    const std::vector<T>& items() const { return this->c; }
+    void restoreItems(const std::vector<T>& heapOrder) { this->c = heapOrder; }
+};
+
+#endif // RUNQUEUES_H
\ No newline at end of file
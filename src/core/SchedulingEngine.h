@@ -0,0 +1,206 @@
+#ifndef SCHEDULINGENGINE_H
+#define SCHEDULINGENGINE_H
+
+#include "../Scheduler.h"
+#include "../utils/AllocationCounter.h"
+#include "Profiler.h"
+#include "TimeSeriesSampler.h"
+#include <algorithm>
+#include <iostream>
+#include <type_traits>
+
+// The simulation loop, instantiated once per policy type. Concrete policies are
+// declared final, so every call on `Policy&` below binds statically and the
+// compiler can inline the policy's selection, arrival and preemption logic into
+// the loop. Instantiated on Scheduler itself it is the generic virtual path.
+template <typename Policy>
+class SchedulingEngine {
+public:
+    // Steps until every process finished or time reaches stopTime
+    static void run(Policy& policy, int stopTime) {
+        Scheduler& base = policy;
+        long long allocationsBefore = AllocationCounter::count();
+        base.beginRun();
+        while (base.completedCount < base.processes.size() && base.currentTime < stopTime) {
+            step(policy);
+        }
+        base.arrivalCursorActive = false;
+        base.loopAllocations = AllocationCounter::count() - allocationsBefore;
+    }
+    
+    static void step(Policy& policy) {
+        Scheduler& base = policy;
+        if (base.verbose && base.currentTime % 5 == 0) {
+            std::cout << "\n--- Time " << base.currentTime << " ---" << std::endl;
+        }
+        
+        {
+            ScopedPhase timer(base.profile, PHASE_ADMIT);
+            admitArrivals(policy);
+        }
+        {
+            ScopedPhase timer(base.profile, PHASE_ASSIGN);
+            assign(policy);
+        }
+        if constexpr (PROFILING_ENABLED) {
+            sampleProfile(policy);
+        }
+        if (base.sampler) {
+            base.sampler->observe(base.currentTime, policy.getWaitingCount(), base.cpus);
+        }
+        if (!base.observers.empty()) {
+            size_t running = reportOccupants(base, base.currentTime);
+            size_t waiting = policy.getWaitingCount();
+            for (auto* observer : base.observers) {
+                observer->onTick(base.currentTime, waiting, running);
+            }
+        }
+        
+        const size_t cpuCount = base.cpus.size();
+        for (size_t i = 0; i < cpuCount; ++i) {
+            bool completed;
+            {
+                ScopedPhase timer(base.profile, PHASE_TICK);
+                completed = base.cpus[i]->tick(base.currentTime);
+            }
+            base.completedCount += completed;
+            if constexpr (PROFILING_ENABLED) {
+                base.profile.completions += completed;
+            }
+            if (base.preemptive) {
+                ScopedPhase timer(base.profile, PHASE_PREEMPT);
+                policy.preempt(static_cast<int>(i));
+            }
+        }
+        
+        // Completions and preemptions take effect at the end of the tick
+        if (!base.observers.empty()) {
+            reportOccupants(base, base.currentTime + 1);
+        }
+        
+        if (base.verbose && base.currentTime % 5 == 0) {
+            base.displayCurrentState();
+        }
+        
+        base.advanceTime();
+    }
+    
+private:
+    static void admitArrivals(Policy& policy) {
+        Scheduler& base = policy;
+        if (base.arrivalCursorActive) {
+            while (base.arrivalCursor < base.arrivalOrder.size()) {
+                const auto& process = base.processes[base.arrivalOrder[base.arrivalCursor]];
+                if (process->getArrivalTime() > base.currentTime) break;
+                base.arrivalCursor++;
+                if (process->getState() == NEW) {
+                    process->setState(READY);
+                    base.readyQueue.push(process);
+                    policy.onProcessArrival(process);
+                    for (auto* observer : base.observers) {
+                        observer->onArrival(base.currentTime, *process);
+                    }
+                    if constexpr (PROFILING_ENABLED) {
+                        base.profile.arrivals++;
+                    }
+                }
+            }
+            return;
+        }
+        
+        // Streaming runs add and retire processes as they go, so they scan
+        for (const auto& process : base.processes) {
+            if (process->getArrivalTime() <= base.currentTime && process->getState() == NEW) {
+                process->setState(READY);
+                base.readyQueue.push(process);
+                policy.onProcessArrival(process);
+                for (auto* observer : base.observers) {
+                    observer->onArrival(base.currentTime, *process);
+                }
+                if constexpr (PROFILING_ENABLED) {
+                    base.profile.arrivals++;
+                }
+            }
+        }
+    }
+    
+    static void assign(Policy& policy) {
+        Scheduler& base = policy;
+        
+        // Policies with their own assignment (e.g. gang scheduling) keep it,
+        // and the generic instantiation has to dispatch to whatever exists
+        if constexpr (std::is_same<Policy, Scheduler>::value ||
+                      !std::is_same<decltype(&Policy::assignProcessesToCPUs),
+                                    void (Scheduler::*)()>::value) {
+            policy.assignProcessesToCPUs();
+            return;
+        } else {
+            if (base.placement != PLACE_BY_INDEX) {
+                base.Scheduler::assignProcessesToCPUs();
+                return;
+            }
+            for (auto& cpu : base.cpus) {
+                if (cpu->getIsIdle()) {
+                    std::shared_ptr<Process> nextProcess;
+                    {
+                        ScopedPhase timer(base.profile, PHASE_SELECT);
+                        nextProcess = policy.selectNextProcess();
+                    }
+                    if (nextProcess) {
+                        cpu->assignProcess(nextProcess);
+                    }
+                }
+            }
+        }
+    }
+    
+    // Tells observers about every CPU whose occupant changed since they last
+    // looked; returns the busy CPUs
+    static size_t reportOccupants(Scheduler& base, int time) {
+        size_t running = 0;
+        for (size_t i = 0; i < base.cpus.size(); ++i) {
+            const Process* occupant = base.cpus[i]->getOccupant();
+            const Process* previous = base.observedOccupants[i];
+            running += occupant != nullptr;
+            if (occupant == previous) continue;
+            
+            int cpuID = static_cast<int>(i);
+            for (auto* observer : base.observers) {
+                if (previous) {
+                    observer->onRelease(time, cpuID, *previous, previous->isCompleted());
+                }
+                if (occupant) {
+                    observer->onDispatch(time, cpuID, *occupant);
+                }
+            }
+            base.observedOccupants[i] = occupant;
+        }
+        return running;
+    }
+    
+    // Queue and occupancy high-water marks, once assignment has settled
+    static void sampleProfile(Policy& policy) {
+        Scheduler& base = policy;
+        RunProfile& profile = base.profile;
+        size_t busy = 0;
+        for (const auto& cpu : base.cpus) {
+            busy += !cpu->getIsIdle();
+        }
+        profile.ticks++;
+        profile.readyHighWater = std::max(profile.readyHighWater, policy.getWaitingCount());
+        profile.runningHighWater = std::max(profile.runningHighWater, busy);
+    }
+};
+
+// Base for concrete policies: routes the façade's run loop and single steps
+// into the engine specialised for the derived type
+template <typename Derived>
+class PolicyScheduler : public Scheduler {
+protected:
+    PolicyScheduler(int numCPUs, const std::string& name) : Scheduler(numCPUs, name) {}
+    
+    void runLoop(int stopTime) override { SchedulingEngine<Derived>::run(static_cast<Derived&>(*this), stopTime); }
+    void step() override { SchedulingEngine<Derived>::step(static_cast<Derived&>(*this)); }
+};
+
+#endif // SCHEDULINGENGINE_H
\ No newline at end of file
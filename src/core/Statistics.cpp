@@ -1,7 +1,10 @@
 #include "Statistics.h"
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 #include <fstream>
+#include <sstream>
+#include <cmath>
 
 void Statistics::compareAlgorithms(
     const std::vector<std::unique_ptr<Scheduler>>& schedulers,
@@ -10,14 +13,22 @@ void Statistics::compareAlgorithms(
     std::vector<std::string> algorithmNames;
     std::vector<double> avgWaitingTimes, avgTurnaroundTimes, avgResponseTimes, cpuUtilizations;
     
+    ResultsTable table;
+    table.reserve(schedulers.size() * testProcesses.size());
     for (const auto& scheduler : schedulers) {
-        algorithmNames.push_back(scheduler->getAlgorithmName());
-        avgWaitingTimes.push_back(scheduler->calculateAverageWaitingTime());
-        avgTurnaroundTimes.push_back(scheduler->calculateAverageTurnaroundTime());
-        avgResponseTimes.push_back(scheduler->calculateAverageResponseTime());
+        table.appendRun(*scheduler);
         cpuUtilizations.push_back(scheduler->calculateAverageCPUUtilization());
     }
     
+    // One row per scheduler in the order of `schedulers`, so rows stay aligned
+    // with the utilizations even when two runs share an algorithm name
+    for (const auto& group : table.groupBy(GROUP_BY_RUN)) {
+        algorithmNames.push_back(group.label);
+        avgWaitingTimes.push_back(group.avgWaitingTime);
+        avgTurnaroundTimes.push_back(group.avgTurnaroundTime);
+        avgResponseTimes.push_back(group.avgResponseTime);
+    }
+    
     printComparisonTable(algorithmNames, avgWaitingTimes, avgTurnaroundTimes, 
                         avgResponseTimes, cpuUtilizations);
 }
@@ -51,29 +62,173 @@ void Statistics::printComparisonTable(
     std::cout << std::string(100, '-') << std::endl;
 }
 
+void Statistics::printGroupTable(const std::string& title,
+                                 const std::vector<GroupSummary>& groups) {
+    // Label column fits the longest label plus a separating gap
+    size_t labelWidth = 50;
+    for (const auto& group : groups) {
+        labelWidth = std::max(labelWidth, group.label.size() + 2);
+    }
+    const size_t ruleWidth = labelWidth + 60;
+    const int labelColumn = static_cast<int>(labelWidth);
+    
+    std::cout << "\n" << title << std::endl;
+    std::cout << std::string(ruleWidth, '-') << std::endl;
+    std::cout << std::left << std::setw(labelColumn) << "Group"
+              << std::setw(10) << "Count"
+              << std::setw(15) << "Avg Wait Time"
+              << std::setw(20) << "Avg Turnaround Time"
+              << std::setw(15) << "Avg Response" << std::endl;
+    std::cout << std::string(ruleWidth, '-') << std::endl;
+    
+    for (const auto& group : groups) {
+        std::cout << std::left << std::setw(labelColumn) << group.label
+                  << std::setw(10) << group.count
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(15) << group.avgWaitingTime
+                  << std::setw(20) << group.avgTurnaroundTime
+                  << std::setw(15) << group.avgResponseTime << std::endl;
+    }
+    std::cout << std::string(ruleWidth, '-') << std::endl;
+}
+
+// "mean +/- half-width" for one table cell
+static std::string interval(const RunningStatistic& statistic, double confidence) {
+    std::ostringstream cell;
+    cell << std::fixed << std::setprecision(2) << statistic.getMean()
+         << " +/- " << statistic.halfWidth(confidence);
+    return cell.str();
+}
+
+void Statistics::printReplicationTable(const ReplicationResult& result) {
+    std::cout << "\n" << std::string(140, '=') << std::endl;
+    std::cout << "ALGORITHM COMPARISON (" << result.replications << " replications, "
+              << std::fixed << std::setprecision(0) << result.confidence * 100 << "% confidence intervals)" << std::endl;
+    std::cout << std::string(140, '=') << std::endl;
+    
+    std::cout << std::left << std::setw(37) << "Algorithm"
+              << std::setw(20) << "Avg Wait Time"
+              << std::setw(21) << "Avg Turnaround Time"
+              << std::setw(20) << "Avg Response Time"
+              << std::setw(20) << "CPU Utilization %"
+              << "Diff from best" << std::endl;
+    std::cout << std::string(140, '-') << std::endl;
+    
+    for (size_t c = 0; c < result.configurations.size(); ++c) {
+        const ReplicationSummary& summary = result.configurations[c];
+        const RunningStatistic& difference = summary.differenceFromBest;
+        std::string verdict = "best";
+        if (c != result.bestConfiguration) {
+            // The interval of the paired difference excludes zero
+            bool significant = std::fabs(difference.getMean()) > difference.halfWidth(result.confidence);
+            verdict = interval(difference, result.confidence) + (significant ? "" : " (not significant)");
+        }
+        std::cout << std::left << std::setw(37) << summary.name
+                  << std::setw(20) << interval(summary.metrics[METRIC_WAITING], result.confidence)
+                  << std::setw(21) << interval(summary.metrics[METRIC_TURNAROUND], result.confidence)
+                  << std::setw(20) << interval(summary.metrics[METRIC_RESPONSE], result.confidence)
+                  << std::setw(20) << interval(summary.metrics[METRIC_UTILIZATION], result.confidence)
+                  << verdict << std::endl;
+    }
+    std::cout << std::string(140, '-') << std::endl;
+    
+    std::cout << "Best by " << ReplicationRunner::metricName(result.targetMetric) << ": "
+              << result.configurations[result.bestConfiguration].name << ". ";
+    if (result.targetPrecision <= 0.0) {
+        std::cout << "Ran a fixed number of replications." << std::endl;
+    } else if (result.converged) {
+        std::cout << "Every interval is within " << std::setprecision(1) << result.targetPrecision * 100
+                  << "% of its mean." << std::endl;
+    } else {
+        std::cout << "Target precision of " << std::setprecision(1) << result.targetPrecision * 100
+                  << "% not reached; raise the replication limit." << std::endl;
+    }
+}
+
+// "12.34%" for one table cell
+static std::string percentage(double value) {
+    std::ostringstream cell;
+    cell << std::fixed << std::setprecision(2) << value << "%";
+    return cell.str();
+}
+
+void Statistics::printSweepTable(const std::vector<SweepResult>& results) {
+    std::cout << "\n" << std::string(140, '=') << std::endl;
+    std::cout << "SWEEP COMPARISON (" << results.size() << " configurations)" << std::endl;
+    std::cout << std::string(140, '=') << std::endl;
+    
+    std::cout << std::left << std::setw(55) << "Configuration"
+              << std::setw(15) << "Avg Wait Time"
+              << std::setw(20) << "Avg Turnaround Time"
+              << std::setw(20) << "Avg Response Time"
+              << std::setw(18) << "CPU Utilization"
+              << "Switches" << std::endl;
+    std::cout << std::string(140, '-') << std::endl;
+    
+    for (const auto& result : results) {
+        std::cout << std::left << std::setw(55) << result.name
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(15) << result.summary.avgWaitingTime
+                  << std::setw(20) << result.summary.avgTurnaroundTime
+                  << std::setw(20) << result.summary.avgResponseTime
+                  << std::setw(18) << percentage(result.summary.cpuUtilization)
+                  << result.summary.contextSwitches << std::endl;
+    }
+    std::cout << std::string(140, '-') << std::endl;
+}
+
 void Statistics::saveResultsToFile(const std::string& filename,
                                   const std::string& algorithmName,
                                   const std::vector<std::shared_ptr<Process>>& processes) {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
+    ResultsFileWriter file(filename, algorithmName);
+    if (!file.isOpen()) {
         std::cerr << "Error: Could not open file " << filename << std::endl;
         return;
     }
     
-    file << "Algorithm: " << algorithmName << std::endl;
-    file << "Process,Arrival,Burst,Priority,Completion,Turnaround,Waiting,Response" << std::endl;
-    
     for (const auto& process : processes) {
-        file << process->getProcessName() << ","
-             << process->getArrivalTime() << ","
-             << process->getBurstTime() << ","
-             << process->getPriority() << ","
-             << process->getCompletionTime() << ","
-             << process->getTurnaroundTime() << ","
-             << process->getWaitingTime() << ","
-             << process->getResponseTime() << std::endl;
+        file.write(*process);
     }
     
-    file.close();
+    if (!file.close()) {
+        std::cerr << "Error: Could not write file " << filename << std::endl;
+        return;
+    }
     std::cout << "Results saved to " << filename << std::endl;
+}
+
+// JSON Lines records are self-contained, so each one also names the algorithm
+static std::vector<std::string> resultFields(RecordFormat format) {
+    std::vector<std::string> fields = {"Process", "Arrival", "Burst", "Priority",
+                                       "Completion", "Turnaround", "Waiting", "Response"};
+    if (format == FORMAT_JSONL) {
+        fields.insert(fields.begin(), "Algorithm");
+    }
+    return fields;
+}
+
+ResultsFileWriter::ResultsFileWriter(const std::string& filename, const std::string& algorithm,
+                                     bool backgroundThread)
+    : file(filename, backgroundThread), format(RecordWriter::formatForFile(filename)),
+      records(file, format, resultFields(format)), algorithmName(algorithm), written(0) {
+    if (format == FORMAT_CSV) {
+        file << "Algorithm: " << algorithmName << '\n';
+    }
+    records.writeHeader();
+}
+
+void ResultsFileWriter::write(const Process& process) {
+    if (format == FORMAT_JSONL) {
+        records.field(algorithmName);
+    }
+    records.field(process.getProcessName())
+           .field(process.getArrivalTime())
+           .field(process.getBurstTime())
+           .field(process.getPriority())
+           .field(process.getCompletionTime())
+           .field(process.getTurnaroundTime())
+           .field(process.getWaitingTime())
+           .field(process.getResponseTime());
+    records.endRecord();
+    written++;
 }
\ No newline at end of file
@@ -2,6 +2,10 @@
 #define STATISTICS_H
 
 #include "../Scheduler.h"
+#include "ResultsTable.h"
+#include "ReplicationRunner.h"
+#include "SweepRunner.h"
+#include "../utils/AsyncWriter.h"
 #include <vector>
 #include <string>
 
@@ -18,9 +22,41 @@ public:
         const std::vector<double>& avgResponseTimes,
         const std::vector<double>& cpuUtilizations);
         
+    static void printGroupTable(const std::string& title,
+                                const std::vector<GroupSummary>& groups);
+    
+    // Comparison table with a confidence interval on every mean and each
+    // configuration's paired difference from the best one
+    static void printReplicationTable(const ReplicationResult& result);
+    
+    // One row per configuration of a merged sweep, in grid order
+    static void printSweepTable(const std::vector<SweepResult>& results);
+    
     static void saveResultsToFile(const std::string& filename,
                                  const std::string& algorithmName,
                                  const std::vector<std::shared_ptr<Process>>& processes);
 };
 
+// Per-process results written through a background writer, as CSV or, for
+// ".jsonl" files, JSON Lines. Doubles as the sink for processes retired by a
+// streaming run, so results of long runs are written while they simulate.
+class ResultsFileWriter : public RetirementSink {
+private:
+    AsyncWriter file;
+    RecordFormat format;
+    RecordWriter records;
+    std::string algorithmName;
+    long long written;
+    
+public:
+    ResultsFileWriter(const std::string& filename, const std::string& algorithm,
+                      bool backgroundThread = true);
+    
+    bool isOpen() const { return file.isOpen(); }
+    void write(const Process& process);
+    void onRetired(const Process& process) override { write(process); }
+    bool close() { return file.close(); }
+    long long getRecordCount() const { return written; }
+};
+
 #endif // STATISTICS_H
\ No newline at end of file
@@ -0,0 +1,180 @@
+#include "SweepRunner.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+static std::string replaceAll(std::string text, const std::string& from, const std::string& to) {
+    for (size_t at = text.find(from); at != std::string::npos; at = text.find(from, at + to.size())) {
+        text.replace(at, from.size(), to);
+    }
+    return text;
+}
+
+SweepRunner::SweepRunner(const std::string& sweepDirectory, int shardCount)
+    : directory(sweepDirectory), shards(shardCount), key(0) {
+    if (shards < 1) {
+        throw std::invalid_argument("A sweep needs at least one shard");
+    }
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (!std::filesystem::is_directory(directory)) {
+        throw std::runtime_error("Could not create sweep directory " + directory);
+    }
+}
+
+void SweepRunner::addConfiguration(const std::string& name, SchedulerFactory factory) {
+    names.push_back(name);
+    factories.push_back(factory);
+}
+
+void SweepRunner::setWorkload(std::shared_ptr<const Workload> sweepWorkload) {
+    workload = std::move(sweepWorkload);
+    
+    std::ostringstream description;
+    description << SIMULATOR_VERSION << "\n" << shards << "\n"
+                << std::hex << ResultCache::hashWorkload(*workload) << std::dec << "\n";
+    for (size_t i = 0; i < factories.size(); ++i) {
+        description << names[i] << "\n" << factories[i]()->describeSetup() << "\n";
+    }
+    key = ResultCache::hashText(description.str());
+}
+
+std::string SweepRunner::shardPath(int shard) const {
+    std::string name = "shard-" + std::to_string(shard) + "-of-" + std::to_string(shards) + ".result";
+    return (std::filesystem::path(directory) / name).string();
+}
+
+void SweepRunner::runShard(int shard) {
+    if (shard < 0 || shard >= shards) {
+        throw std::invalid_argument("Shard " + std::to_string(shard) + " is out of range");
+    }
+    if (!workload) {
+        throw std::logic_error("Sweep has no workload");
+    }
+    
+    std::vector<std::pair<size_t, SimulationResult>> results;
+    for (size_t i = shard; i < factories.size(); i += shards) {
+        auto scheduler = factories[i]();
+        scheduler->setQuiet(true);
+        scheduler->setWorkload(workload);
+        scheduler->run();
+        results.emplace_back(i, SimulationResult::fromScheduler(*scheduler));
+    }
+    
+    std::string path = shardPath(shard);
+    std::ostringstream suffix;
+    suffix << ".tmp" << std::this_thread::get_id();
+    std::string temporary = path + suffix.str();
+    {
+        std::ofstream file(temporary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not open file " + temporary);
+        }
+        file << "# scheduler sweep shard " << shard << " of " << shards << "\n"
+             << std::hex << key << std::dec << " " << results.size() << "\n" << std::setprecision(17);
+        for (const auto& entry : results) {
+            const SimulationResult& result = entry.second;
+            file << entry.first << " " << result.endTime << " " << result.contextSwitches << " "
+                 << result.avgWaitingTime << " " << result.avgTurnaroundTime << " " << result.avgResponseTime << " "
+                 << result.cpuUtilization << " " << result.throughput << "\n";
+        }
+        if (!file) {
+            throw std::runtime_error("Could not write file " + temporary);
+        }
+    }
+    std::filesystem::rename(temporary, path);
+}
+
+// Fills the shard's entries of `results`, which holds one per configuration
+bool SweepRunner::loadShard(int shard, std::vector<SweepResult>& results) const {
+    std::ifstream file(shardPath(shard));
+    if (!file.is_open()) return false;
+    
+    std::string line;
+    std::string expected = "# scheduler sweep shard " + std::to_string(shard) + " of " + std::to_string(shards);
+    if (!std::getline(file, line) || line != expected) return false;
+    uint64_t storedKey = 0;
+    size_t rows = 0;
+    if (!(file >> std::hex >> storedKey >> std::dec >> rows) || storedKey != key) return false;
+    
+    size_t expectedRows = factories.size() > static_cast<size_t>(shard)
+        ? (factories.size() - shard + shards - 1) / shards : 0;
+    if (rows != expectedRows) return false;
+    for (size_t r = 0; r < rows; ++r) {
+        size_t index = 0;
+        SimulationResult summary;
+        file >> index >> summary.endTime >> summary.contextSwitches >> summary.avgWaitingTime
+             >> summary.avgTurnaroundTime >> summary.avgResponseTime >> summary.cpuUtilization >> summary.throughput;
+        if (!file || index >= results.size() || index % shards != static_cast<size_t>(shard)) return false;
+        summary.algorithm = results[index].summary.algorithm;
+        results[index].summary = summary;
+    }
+    return true;
+}
+
+std::vector<int> SweepRunner::missingShards() const {
+    std::vector<SweepResult> scratch(factories.size());
+    std::vector<int> missing;
+    for (int shard = 0; shard < shards; ++shard) {
+        if (!loadShard(shard, scratch)) {
+            missing.push_back(shard);
+        }
+    }
+    return missing;
+}
+
+std::vector<int> SweepRunner::launchMissing(const std::string& commandTemplate, int parallel) const {
+    std::vector<int> missing = missingShards();
+    std::vector<int> exitCodes(missing.size(), 0);
+    std::atomic<size_t> nextIndex(0);
+    auto worker = [&]() {
+        for (size_t i = nextIndex++; i < missing.size(); i = nextIndex++) {
+            std::string command = replaceAll(commandTemplate, "{shards}", std::to_string(shards));
+            command = replaceAll(command, "{shard}", std::to_string(missing[i]));
+            exitCodes[i] = std::system(command.c_str());
+        }
+    };
+    
+    size_t workers = std::min(missing.size(), static_cast<size_t>(std::max(1, parallel)));
+    if (workers <= 1) {
+        worker();
+    } else {
+        std::vector<std::future<void>> running;
+        for (size_t i = 0; i < workers; ++i) {
+            running.push_back(std::async(std::launch::async, worker));
+        }
+        for (auto& future : running) {
+            future.get();
+        }
+    }
+    
+    std::vector<int> failed;
+    for (size_t i = 0; i < missing.size(); ++i) {
+        if (exitCodes[i] != 0) {
+            failed.push_back(missing[i]);
+        }
+    }
+    return failed;
+}
+
+std::vector<SweepResult> SweepRunner::merge() const {
+    std::vector<SweepResult> results(factories.size());
+    for (size_t i = 0; i < factories.size(); ++i) {
+        results[i].name = names[i];
+        results[i].summary.algorithm = factories[i]()->getAlgorithmName();
+    }
+    for (int shard = 0; shard < shards; ++shard) {
+        if (!loadShard(shard, results)) {
+            throw std::runtime_error("Shard " + std::to_string(shard) + " is missing or from another sweep: " +
+                                     shardPath(shard));
+        }
+    }
+    return results;
+}
\ No newline at end of file
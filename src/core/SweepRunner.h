@@ -0,0 +1,67 @@
+#ifndef SWEEPRUNNER_H
+#define SWEEPRUNNER_H
+
+#include "../Scheduler.h"
+#include "ResultCache.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// One configuration's summary statistics from a merged sweep
+struct SweepResult {
+    std::string name;
+    SimulationResult summary;           // per-process columns are left empty
+};
+
+// Splits a grid of configurations into shards that separate processes run,
+// possibly on other hosts sharing the directory, so no process holds more
+// than one workload and one scheduler at a time. Configuration i belongs to
+// shard i mod shards. Each shard writes one file, under a temporary name and
+// renamed when complete, headed by a key that hashes the simulator version,
+// the shard count, every configuration's setup and the workload. A shard
+// whose file is missing or has another key is missing, so after a failure
+// only those shards run again; merging reads the shards back in grid order,
+// so the merged table never depends on which shards ran where or when.
+class SweepRunner {
+public:
+    typedef std::function<std::unique_ptr<Scheduler>()> SchedulerFactory;
+    
+private:
+    std::string directory;
+    int shards;
+    std::vector<std::string> names;
+    std::vector<SchedulerFactory> factories;
+    std::shared_ptr<const Workload> workload;
+    uint64_t key;
+    
+    std::string shardPath(int shard) const;
+    bool loadShard(int shard, std::vector<SweepResult>& results) const;
+    
+public:
+    SweepRunner(const std::string& sweepDirectory, int shardCount);
+    
+    void addConfiguration(const std::string& name, SchedulerFactory factory);
+    
+    // Fixes the sweep's key; call after adding every configuration
+    void setWorkload(std::shared_ptr<const Workload> sweepWorkload);
+    
+    // Runs one shard's configurations in turn and writes its file
+    void runShard(int shard);
+    
+    std::vector<int> missingShards() const;
+    
+    // Runs commandTemplate for every missing shard, `parallel` at a time, with
+    // {shard} replaced by the shard number and {shards} by the shard count;
+    // returns the shards whose command failed
+    std::vector<int> launchMissing(const std::string& commandTemplate, int parallel) const;
+    
+    // Every configuration's result in grid order; throws if a shard is missing
+    std::vector<SweepResult> merge() const;
+    
+    int getShardCount() const { return shards; }
+    size_t getConfigurationCount() const { return factories.size(); }
+};
+
+#endif // SWEEPRUNNER_H
\ No newline at end of file
@@ -0,0 +1,172 @@
+#include "TimeSeriesSampler.h"
+#include "../utils/AsyncWriter.h"
+#include <algorithm>
+#include <stdexcept>
+
+TimeSeriesSampler::TimeSeriesSampler(int cpuCount, int sampleInterval, size_t bucketsPerLevel,
+                                     int levelCount, int consolidationFactor)
+    : seriesCount(SERIES_FIRST_CPU + std::max(0, cpuCount)), interval(sampleInterval),
+      capacity(bucketsPerLevel), factor(consolidationFactor) {
+    if (sampleInterval < 1 || bucketsPerLevel < 1 || levelCount < 1 || consolidationFactor < 2) {
+        throw std::invalid_argument("Sampler needs an interval and bucket count of at least 1, "
+                                    "at least one level and a consolidation factor of at least 2");
+    }
+    
+    // Everything is allocated here so observing never allocates
+    levels.resize(levelCount);
+    for (auto& level : levels) {
+        level.startTimes.resize(capacity);
+        level.ticks.resize(capacity);
+        level.stats.resize(capacity * seriesCount);
+        level.open.resize(seriesCount);
+    }
+    clear();
+}
+
+void TimeSeriesSampler::clear() {
+    for (auto& level : levels) {
+        level.next = 0;
+        level.filled = 0;
+        level.openStart = 0;
+        level.openTicks = 0;
+        level.openParts = 0;
+    }
+}
+
+void TimeSeriesSampler::observe(int time, size_t waiting, const std::vector<std::unique_ptr<CPU>>& cpus) {
+    Level& first = levels[0];
+    SeriesStats* open = first.open.data();
+    if (first.openParts == 0) {
+        first.openStart = time;
+        for (size_t s = 0; s < seriesCount; ++s) {
+            open[s] = SeriesStats{1e300, -1e300, 0.0};
+        }
+    }
+    
+    size_t running = 0;
+    size_t cpuSeries = std::min(cpus.size(), seriesCount - SERIES_FIRST_CPU);
+    for (size_t i = 0; i < cpuSeries; ++i) {
+        double busy = cpus[i]->getIsIdle() ? 0.0 : 1.0;
+        running += !cpus[i]->getIsIdle();
+        SeriesStats& stats = open[SERIES_FIRST_CPU + i];
+        stats.minimum = std::min(stats.minimum, busy);
+        stats.maximum = std::max(stats.maximum, busy);
+        stats.sum += busy;
+    }
+    double values[SERIES_FIRST_CPU] = {static_cast<double>(waiting), static_cast<double>(running)};
+    for (size_t s = 0; s < SERIES_FIRST_CPU; ++s) {
+        open[s].minimum = std::min(open[s].minimum, values[s]);
+        open[s].maximum = std::max(open[s].maximum, values[s]);
+        open[s].sum += values[s];
+    }
+    first.openTicks++;
+    
+    if (++first.openParts == interval) {
+        commit(0);
+    }
+}
+
+void TimeSeriesSampler::merge(Level& level, int startTime, long long ticks, const SeriesStats* stats) {
+    if (level.openParts == 0) {
+        level.openStart = startTime;
+        std::copy(stats, stats + seriesCount, level.open.begin());
+    } else {
+        for (size_t s = 0; s < seriesCount; ++s) {
+            level.open[s].minimum = std::min(level.open[s].minimum, stats[s].minimum);
+            level.open[s].maximum = std::max(level.open[s].maximum, stats[s].maximum);
+            level.open[s].sum += stats[s].sum;
+        }
+    }
+    level.openTicks += ticks;
+    level.openParts++;
+}
+
+// Moves a level's open bucket into its ring and on into the level above
+void TimeSeriesSampler::commit(size_t index) {
+    Level& level = levels[index];
+    level.startTimes[level.next] = level.openStart;
+    level.ticks[level.next] = level.openTicks;
+    std::copy(level.open.begin(), level.open.end(), level.stats.begin() + level.next * seriesCount);
+    
+    if (index + 1 < levels.size()) {
+        Level& above = levels[index + 1];
+        merge(above, level.openStart, level.openTicks, level.open.data());
+        if (above.openParts == factor) {
+            commit(index + 1);
+        }
+    }
+    
+    level.next = (level.next + 1) % capacity;
+    level.filled = std::min(level.filled + 1, capacity);
+    level.openTicks = 0;
+    level.openParts = 0;
+}
+
+// Partial buckets go up the levels too, so every level covers the whole run
+void TimeSeriesSampler::flush() {
+    for (size_t index = 0; index < levels.size(); ++index) {
+        if (levels[index].openParts > 0) {
+            commit(index);
+        }
+    }
+}
+
+long long TimeSeriesSampler::getBucketTicks(size_t level) const {
+    long long ticks = interval;
+    for (size_t i = 0; i < level; ++i) {
+        ticks *= factor;
+    }
+    return ticks;
+}
+
+size_t TimeSeriesSampler::slot(size_t level, size_t index) const {
+    const Level& kept = levels[level];
+    return (kept.next + capacity - kept.filled + index) % capacity;
+}
+
+int TimeSeriesSampler::getBucketStart(size_t level, size_t index) const {
+    return levels[level].startTimes[slot(level, index)];
+}
+
+long long TimeSeriesSampler::getBucketTickCount(size_t level, size_t index) const {
+    return levels[level].ticks[slot(level, index)];
+}
+
+const SeriesStats& TimeSeriesSampler::getStats(size_t level, size_t index, size_t series) const {
+    return levels[level].stats[slot(level, index) * seriesCount + series];
+}
+
+bool TimeSeriesSampler::saveToCSV(const std::string& filename) const {
+    AsyncWriter file(filename, false);
+    if (!file.isOpen()) return false;
+    
+    std::vector<std::string> fields = {"level", "start", "ticks",
+                                       "waiting_min", "waiting_max", "waiting_avg",
+                                       "running_min", "running_max", "running_avg"};
+    for (int cpu = 0; cpu < getCPUCount(); ++cpu) {
+        std::string name = "cpu" + std::to_string(cpu) + "_util";
+        fields.push_back(name + "_min");
+        fields.push_back(name + "_max");
+        fields.push_back(name + "_avg");
+    }
+    RecordWriter records(file, FORMAT_CSV, fields);
+    records.writeHeader();
+    
+    for (size_t level = levels.size(); level-- > 0;) {
+        for (size_t index = 0; index < getBucketCount(level); ++index) {
+            long long ticks = getBucketTickCount(level, index);
+            records.field(static_cast<long long>(level))
+                   .field(getBucketStart(level, index))
+                   .field(ticks);
+            for (size_t series = 0; series < seriesCount; ++series) {
+                const SeriesStats& stats = getStats(level, index, series);
+                double scale = series >= SERIES_FIRST_CPU ? 100.0 : 1.0;
+                records.field(stats.minimum * scale)
+                       .field(stats.maximum * scale)
+                       .field(stats.sum / ticks * scale);
+            }
+            records.endRecord();
+        }
+    }
+    return file.close();
+}
\ No newline at end of file
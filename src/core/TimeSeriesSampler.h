@@ -0,0 +1,77 @@
+#ifndef TIMESERIESSAMPLER_H
+#define TIMESERIESSAMPLER_H
+
+#include "CPU.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+struct SeriesStats {
+    double minimum;
+    double maximum;
+    double sum;
+};
+
+// Load over time at several resolutions, in memory fixed at construction.
+// Every tick contributes one value per series: the processes waiting for a CPU,
+// the busy CPUs, and per CPU 1 if busy or 0 if idle (so a CPU's mean is its
+// utilization). Level 0 buckets span `interval` ticks and each higher level
+// consolidates `factor` buckets of the level below into min/max/mean, the way
+// round-robin databases do. Each level keeps its latest `capacity` buckets in a
+// ring, so a long run keeps recent detail and a coarse view of all of it.
+class TimeSeriesSampler {
+public:
+    enum { SERIES_WAITING, SERIES_RUNNING, SERIES_FIRST_CPU };
+    
+private:
+    struct Level {
+        std::vector<int> startTimes;
+        std::vector<long long> ticks;
+        std::vector<SeriesStats> stats;     // seriesCount entries per bucket
+        size_t next;                        // ring slot for the next bucket
+        size_t filled;
+        
+        // Bucket still being accumulated
+        int openStart;
+        long long openTicks;
+        int openParts;                      // ticks (level 0) or lower buckets merged
+        std::vector<SeriesStats> open;
+    };
+    
+    size_t seriesCount;
+    int interval;
+    size_t capacity;
+    int factor;
+    std::vector<Level> levels;
+    
+    void merge(Level& level, int startTime, long long ticks, const SeriesStats* stats);
+    void commit(size_t level);
+    size_t slot(size_t level, size_t index) const;
+    
+public:
+    TimeSeriesSampler(int cpuCount, int sampleInterval = 1, size_t bucketsPerLevel = 1024,
+                      int levelCount = 4, int consolidationFactor = 8);
+    
+    // Called once per simulated tick, after CPUs have been assigned
+    void observe(int time, size_t waiting, const std::vector<std::unique_ptr<CPU>>& cpus);
+    
+    // Closes partly filled buckets at the end of a run
+    void flush();
+    void clear();
+    
+    int getCPUCount() const { return static_cast<int>(seriesCount) - SERIES_FIRST_CPU; }
+    size_t getLevelCount() const { return levels.size(); }
+    long long getBucketTicks(size_t level) const;   // nominal span of a bucket
+    
+    // Buckets kept at a level, oldest first
+    size_t getBucketCount(size_t level) const { return levels[level].filled; }
+    int getBucketStart(size_t level, size_t index) const;
+    long long getBucketTickCount(size_t level, size_t index) const;
+    const SeriesStats& getStats(size_t level, size_t index, size_t series) const;
+    
+    // One row per kept bucket, every level, coarsest first; CPU columns are
+    // utilization percentages
+    bool saveToCSV(const std::string& filename) const;
+};
+
+#endif // TIMESERIESSAMPLER_H
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include "TraceIndex.h"
+#include <algorithm>
+
+TraceIndex::TraceIndex(const std::vector<std::shared_ptr<Process>>& processes, int cpuCount)
+    : byCPU(std::max(0, cpuCount)), endTime(0) {
+    size_t total = 0;
+    for (const auto& process : processes) {
+        total += process->getExecutionHistory().size() + process->getFollowerHistory().size();
+    }
+    byProcess.reserve(total);
+    
+    for (const auto& process : processes) {
+        for (const auto* history : {&process->getExecutionHistory(), &process->getFollowerHistory()}) {
+            for (const auto& slice : *history) {
+                TraceSpan span{slice.start, slice.end(), slice.cpu, process.get()};
+                byProcess.push_back(span);
+                if (slice.cpu >= 0 && slice.cpu < cpuCount) {
+                    byCPU[slice.cpu].push_back(span);
+                }
+                endTime = std::max(endTime, span.end);
+            }
+        }
+    }
+    
+    for (auto& spans : byCPU) {
+        std::sort(spans.begin(), spans.end(), [](const TraceSpan& a, const TraceSpan& b) {
+            return a.start < b.start;
+        });
+    }
+    std::stable_sort(byProcess.begin(), byProcess.end(), [](const TraceSpan& a, const TraceSpan& b) {
+        int idA = a.process->getProcessID(), idB = b.process->getProcessID();
+        return idA != idB ? idA < idB : a.start < b.start;
+    });
+}
+
+const Process* TraceIndex::at(int cpu, int time) const {
+    TraceSpanRange spans = overlapping(cpu, time, time + 1);
+    return spans.empty() ? nullptr : spans.first->process;
+}
+
+TraceSpanRange TraceIndex::overlapping(int cpu, int from, int to) const {
+    if (cpu < 0 || cpu >= getCPUCount() || from >= to) return {nullptr, nullptr};
+    
+    const std::vector<TraceSpan>& spans = byCPU[cpu];
+    auto first = std::upper_bound(spans.begin(), spans.end(), from, [](int time, const TraceSpan& span) {
+        return time < span.end;
+    });
+    auto last = std::lower_bound(first, spans.end(), to, [](const TraceSpan& span, int time) {
+        return span.start < time;
+    });
+    return {spans.data() + (first - spans.begin()), spans.data() + (last - spans.begin())};
+}
+
+TraceSpanRange TraceIndex::ofProcess(int processID) const {
+    auto first = std::lower_bound(byProcess.begin(), byProcess.end(), processID, [](const TraceSpan& span, int id) {
+        return span.process->getProcessID() < id;
+    });
+    auto last = std::upper_bound(first, byProcess.end(), processID, [](int id, const TraceSpan& span) {
+        return id < span.process->getProcessID();
+    });
+    return {byProcess.data() + (first - byProcess.begin()), byProcess.data() + (last - byProcess.begin())};
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+#ifndef TRACEINDEX_H
+#define TRACEINDEX_H
+
+#include "../Process.h"
+#include <memory>
+#include <vector>
+
+struct TraceSpan {
+    int start;
+    int end;
+    int cpu;
+    const Process* process;
+};
+
+// A run of spans in an index, iterable with range-for
+struct TraceSpanRange {
+    const TraceSpan* first;
+    const TraceSpan* last;
+    
+    const TraceSpan* begin() const { return first; }
+    const TraceSpan* end() const { return last; }
+    size_t size() const { return static_cast<size_t>(last - first); }
+    bool empty() const { return first == last; }
+};
+
+// The execution slices of a finished run, sorted two ways: per CPU by time and
+// per process by ID. A CPU runs one process at a time, so its spans are
+// disjoint and their ends are sorted along with their starts, which lets
+// point and range queries binary-search a plain array. Built once in
+// O(N log N); every query is O(log N) plus the spans it returns. The index
+// points into the processes it was built from, which must outlive it. A
+// parallel job has spans on every CPU it held, its followers included.
+class TraceIndex {
+private:
+    std::vector<std::vector<TraceSpan>> byCPU;
+    std::vector<TraceSpan> byProcess;
+    int endTime;
+    
+public:
+    TraceIndex(const std::vector<std::shared_ptr<Process>>& processes, int cpuCount);
+    
+    int getCPUCount() const { return static_cast<int>(byCPU.size()); }
+    int getEndTime() const { return endTime; }     // end of the last span
+    
+    // The process running on `cpu` at `time`, or null if it was idle
+    const Process* at(int cpu, int time) const;
+    
+    // Spans on `cpu` that overlap [from, to), in time order
+    TraceSpanRange overlapping(int cpu, int from, int to) const;
+    
+    // Every span of the process with this ID, in time order
+    TraceSpanRange ofProcess(int processID) const;
+};
+
+#endif // TRACEINDEX_H
\ No newline at end of file
@@ -0,0 +1,21 @@
+#include "Workload.h"
+#include "../utils/WorkloadGenerator.h"
+
+// Definitions are stored reset, so copying one is a complete reinitialisation
+Workload::Workload(const std::vector<std::shared_ptr<Process>>& processes) {
+    definitions.reserve(processes.size());
+    for (const auto& process : processes) {
+        definitions.push_back(*process);
+        definitions.back().reset();
+    }
+}
+
+Workload::Workload(const SyntheticWorkload& synthetic) {
+    definitions.reserve(synthetic.size());
+    for (size_t i = 0; i < synthetic.size(); ++i) {
+        int id = static_cast<int>(i + 1);
+        definitions.emplace_back(id, synthetic.arrivalTimes[i], synthetic.burstTimes[i],
+                                 synthetic.priorities[i], "P" + std::to_string(id));
+        definitions.back().reset();
+    }
+}
\ No newline at end of file
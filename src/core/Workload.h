@@ -0,0 +1,27 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include "../Process.h"
+#include <memory>
+#include <vector>
+
+struct SyntheticWorkload;
+
+// The processes of a scenario as they are before any run. A Workload never
+// changes after construction, so any number of schedulers, on any threads, can
+// share one through a shared_ptr<const Workload> without copying it; each
+// scheduler keeps the run state in its own arena (see Scheduler::setWorkload).
+class Workload {
+private:
+    std::vector<Process> definitions;
+    
+public:
+    explicit Workload(const std::vector<std::shared_ptr<Process>>& processes);
+    explicit Workload(const SyntheticWorkload& synthetic);
+    
+    size_t size() const { return definitions.size(); }
+    const Process& operator[](size_t index) const { return definitions[index]; }
+    const std::vector<Process>& getProcesses() const { return definitions; }
+};
+
+#endif // WORKLOAD_H
\ No newline at end of file
@@ -2,13 +2,38 @@
 #include "algorithms/SJF.h"
 #include "algorithms/RoundRobin.h"
 #include "algorithms/Priority.h"
+#include "algorithms/Gang.h"
+#include "algorithms/GroupScheduler.h"
 #include "utils/InputGenerator.h"
+#include "utils/WorkloadGenerator.h"
+#include "utils/AllocationCounter.h"
+#include "utils/ArrivalStream.h"
+#include "utils/LinuxTraceImporter.h"
+#include "utils/BinaryTrace.h"
 #include "core/Statistics.h"
+#include "core/AnalyticSolver.h"
+#include "core/QuantumTuner.h"
+#include "core/ReplicationRunner.h"
+#include "core/IncrementalSimulator.h"
+#include "core/ResultCache.h"
+#include "core/FusedSimulation.h"
+#include "core/PartitionedSimulation.h"
+#include "core/SweepRunner.h"
+#include "core/TimeSeriesSampler.h"
 #include "visualization/GanttChart.h"
+#include "visualization/ChromeTraceWriter.h"
 #include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <functional>
+#include <chrono>
+#include <limits>
+#include <map>
+#include <sstream>
 #include <memory>
 #include <vector>
 #include <string>
+#include <thread>
 
 void printMainMenu() {
     std::cout << "\n" << std::string(50, '=') << std::endl;
@@ -19,7 +44,8 @@ void printMainMenu() {
     std::cout << "3. Test Multi-Core Scheduling" << std::endl;
     std::cout << "4. Generate Random Test Case" << std::endl;
     std::cout << "5. Load Processes from File" << std::endl;
-    std::cout << "6. Exit" << std::endl;
+    std::cout << "6. Test Heterogeneous CPUs" << std::endl;
+    std::cout << "7. Exit" << std::endl;
     std::cout << "Choice: ";
 }
 
@@ -31,6 +57,9 @@ void printAlgorithmMenu() {
     std::cout << "4. Round Robin" << std::endl;
     std::cout << "5. Priority (Non-preemptive)" << std::endl;
     std::cout << "6. Priority (Preemptive)" << std::endl;
+    std::cout << "7. Gang (FCFS)" << std::endl;
+    std::cout << "8. Gang (EASY Backfilling)" << std::endl;
+    std::cout << "9. Gang (Time-Sliced)" << std::endl;
     std::cout << "Choice: ";
 }
 
@@ -42,6 +71,7 @@ void printTestCaseMenu() {
     std::cout << "4. Multi-Core Test Case" << std::endl;
     std::cout << "5. Convoy Effect Case" << std::endl;
     std::cout << "6. Random Processes" << std::endl;
+    std::cout << "7. Parallel Job Case" << std::endl;
     std::cout << "Choice: ";
 }
 
@@ -68,24 +98,51 @@ std::vector<std::shared_ptr<Process>> getTestCase() {
             std::cin >> maxPriority;
             return InputGenerator::generateRandomProcesses(count, maxArrival, maxBurst, maxPriority);
         }
+        case 7: return InputGenerator::getParallelJobTestCase();
         default:
             return InputGenerator::getClassicTestCase();
     }
 }
 
-std::unique_ptr<Scheduler> createScheduler(int algorithmChoice, int numCPUs = 1) {
+// Simulates Round Robin over a range of quanta and returns the best one
+int tuneQuantum(const std::vector<std::shared_ptr<Process>>& processes, int numCPUs,
+                TuningObjective objective) {
+    QuantumTuner tuner(processes, numCPUs, objective);
+    TuningResult result = tuner.tune();
+    QuantumTuner::printResult(result, objective);
+    return result.bestQuantum;
+}
+
+// A quantum of 0 means ask for it interactively when the algorithm needs one;
+// given the workload, Round Robin can also have its quantum tuned
+std::unique_ptr<Scheduler> createScheduler(int algorithmChoice, int numCPUs = 1, int quantum = 0,
+                                           const std::vector<std::shared_ptr<Process>>* workload = nullptr) {
     switch (algorithmChoice) {
         case 1: return std::make_unique<FCFS>(numCPUs);
         case 2: return std::make_unique<SJF>(numCPUs, false);
         case 3: return std::make_unique<SJF>(numCPUs, true);
         case 4: {
-            int quantum;
-            std::cout << "Enter time quantum: ";
-            std::cin >> quantum;
+            if (quantum <= 0) {
+                std::cout << (workload ? "Enter time quantum (0 = tune for mean response time): "
+                                       : "Enter time quantum: ");
+                std::cin >> quantum;
+            }
+            if (quantum <= 0 && workload) {
+                quantum = tuneQuantum(*workload, numCPUs, TUNE_MEAN_RESPONSE);
+            }
             return std::make_unique<RoundRobin>(quantum, numCPUs);
         }
         case 5: return std::make_unique<Priority>(numCPUs, false);
         case 6: return std::make_unique<Priority>(numCPUs, true);
+        case 7: return std::make_unique<Gang>(numCPUs, GANG_FCFS);
+        case 8: return std::make_unique<Gang>(numCPUs, GANG_EASY_BACKFILL);
+        case 9: {
+            if (quantum <= 0) {
+                std::cout << "Enter time quantum: ";
+                std::cin >> quantum;
+            }
+            return std::make_unique<Gang>(numCPUs, GANG_TIME_SLICED, quantum);
+        }
         default: return std::make_unique<FCFS>(numCPUs);
     }
 }
@@ -102,7 +159,7 @@ void runSingleAlgorithm() {
     int algorithmChoice;
     std::cin >> algorithmChoice;
     
-    auto scheduler = createScheduler(algorithmChoice, numCPUs);
+    auto scheduler = createScheduler(algorithmChoice, numCPUs, 0, &processes);
     scheduler->addProcesses(processes);
     
     std::cout << "\nEnable verbose output? (1=Yes, 0=No): ";
@@ -113,6 +170,9 @@ void runSingleAlgorithm() {
     scheduler->run();
     scheduler->printResults();
     scheduler->printGanttChart();
+    if (auto gang = dynamic_cast<Gang*>(scheduler.get())) {
+        gang->printGangStatistics();
+    }
     
     std::cout << "\nSave results to file? (1=Yes, 0=No): ";
     int save;
@@ -125,48 +185,68 @@ void runSingleAlgorithm() {
     }
 }
 
-void compareAllAlgorithms() {
-    auto processes = getTestCase();
-    InputGenerator::printProcessList(processes);
-    
-    std::cout << "\nNumber of CPUs: ";
-    int numCPUs;
-    std::cin >> numCPUs;
-    
+// Runs the six classic policies on the workload and prints how they compare.
+// With a cache, results of earlier identical runs are reused.
+void compareWorkload(const std::vector<std::shared_ptr<Process>>& processes, int numCPUs, int quantum,
+                     ResultCache* cache) {
     std::vector<std::unique_ptr<Scheduler>> schedulers;
     std::vector<std::string> names;
     std::vector<double> avgWaitingTimes, avgTurnaroundTimes, avgResponseTimes, cpuUtilizations;
+    ResultsTable results;
+    std::string config = std::to_string(numCPUs) + " CPU(s)";
     
     // Create all schedulers
     schedulers.push_back(std::make_unique<FCFS>(numCPUs));
     schedulers.push_back(std::make_unique<SJF>(numCPUs, false));
     schedulers.push_back(std::make_unique<SJF>(numCPUs, true));
-    schedulers.push_back(std::make_unique<RoundRobin>(4, numCPUs));  // Quantum = 4
+    schedulers.push_back(std::make_unique<RoundRobin>(quantum, numCPUs));
     schedulers.push_back(std::make_unique<Priority>(numCPUs, false));
     schedulers.push_back(std::make_unique<Priority>(numCPUs, true));
     
-    // Run each algorithm
+    // Run each algorithm on its own run state over the same workload
+    auto workload = std::make_shared<const Workload>(processes);
     for (auto& scheduler : schedulers) {
-        // Reset processes for each algorithm
-        for (auto& process : processes) {
-            process->reset();
+        if (cache) {
+            long long hitsBefore = cache->getHits();
+            SimulationResult result = cache->run(*scheduler, workload);
+            results.appendResult(result, config);
+            cpuUtilizations.push_back(result.cpuUtilization);
+            std::cout << "\nCompleted: " << result.algorithm
+                      << (cache->getHits() > hitsBefore ? " (cached)" : "") << std::endl;
+            continue;
         }
-        
-        scheduler->addProcesses(processes);
+        scheduler->setWorkload(workload);
         scheduler->run();
         
-        names.push_back(scheduler->getAlgorithmName());
-        avgWaitingTimes.push_back(scheduler->calculateAverageWaitingTime());
-        avgTurnaroundTimes.push_back(scheduler->calculateAverageTurnaroundTime());
-        avgResponseTimes.push_back(scheduler->calculateAverageResponseTime());
+        results.appendRun(*scheduler, config);
         cpuUtilizations.push_back(scheduler->calculateAverageCPUUtilization());
         
         std::cout << "\nCompleted: " << scheduler->getAlgorithmName() << std::endl;
     }
     
+    for (const auto& group : results.groupBy(GROUP_BY_RUN)) {
+        names.push_back(group.label);
+        avgWaitingTimes.push_back(group.avgWaitingTime);
+        avgTurnaroundTimes.push_back(group.avgTurnaroundTime);
+        avgResponseTimes.push_back(group.avgResponseTime);
+    }
+    
     // Print comparison
     Statistics::printComparisonTable(names, avgWaitingTimes, avgTurnaroundTimes, 
                                     avgResponseTimes, cpuUtilizations);
+    Statistics::printGroupTable("BY PRIORITY", results.groupBy(GROUP_BY_ALGORITHM, GROUP_BY_PRIORITY));
+    Statistics::printGroupTable("BY BURST SIZE", results.groupBy(GROUP_BY_ALGORITHM, GROUP_BY_BURST_BUCKET));
+}
+
+void compareAllAlgorithms() {
+    auto processes = getTestCase();
+    InputGenerator::printProcessList(processes);
+    
+    std::cout << "\nNumber of CPUs: ";
+    int numCPUs;
+    std::cin >> numCPUs;
+    
+    compareWorkload(processes, numCPUs, 4, nullptr);
 }
 
 void testMultiCoreScheduling() {
@@ -175,18 +255,14 @@ void testMultiCoreScheduling() {
     
     std::cout << "\nTesting with different CPU counts:" << std::endl;
     
+    auto workload = std::make_shared<const Workload>(processes);
     for (int numCPUs = 1; numCPUs <= 4; ++numCPUs) {
         std::cout << "\n" << std::string(50, '-') << std::endl;
         std::cout << "Testing with " << numCPUs << " CPU(s)" << std::endl;
         std::cout << std::string(50, '-') << std::endl;
         
-        // Reset processes
-        for (auto& process : processes) {
-            process->reset();
-        }
-        
         auto scheduler = std::make_unique<FCFS>(numCPUs);
-        scheduler->addProcesses(processes);
+        scheduler->setWorkload(workload);
         scheduler->run();
         
         std::cout << "Average Waiting Time: " << scheduler->calculateAverageWaitingTime() << std::endl;
@@ -197,6 +273,7 @@ void testMultiCoreScheduling() {
 
 void generateRandomTestCase() {
     int count, maxArrival, maxBurst, maxPriority;
+    unsigned long long seed;
     
     std::cout << "Number of processes: ";
     std::cin >> count;
@@ -206,8 +283,10 @@ void generateRandomTestCase() {
     std::cin >> maxBurst;
     std::cout << "Maximum priority: ";
     std::cin >> maxPriority;
+    std::cout << "Random seed (0 = from clock): ";
+    std::cin >> seed;
     
-    auto processes = InputGenerator::generateRandomProcesses(count, maxArrival, maxBurst, maxPriority);
+    auto processes = InputGenerator::generateRandomProcesses(count, maxArrival, maxBurst, maxPriority, seed);
     InputGenerator::printProcessList(processes);
     
     std::cout << "\nSave to file? (1=Yes, 0=No): ";
@@ -246,7 +325,7 @@ void loadFromFile() {
         int algorithmChoice;
         std::cin >> algorithmChoice;
         
-        auto scheduler = createScheduler(algorithmChoice, numCPUs);
+        auto scheduler = createScheduler(algorithmChoice, numCPUs, 0, &processes);
         scheduler->addProcesses(processes);
         scheduler->run();
         scheduler->printResults();
@@ -254,7 +333,1124 @@ void loadFromFile() {
     }
 }
 
-int main() {
+void testHeterogeneousCPUs() {
+    auto processes = getTestCase();
+    InputGenerator::printProcessList(processes);
+    
+    std::cout << "\nNumber of CPUs: ";
+    int numCPUs;
+    std::cin >> numCPUs;
+    
+    std::vector<double> speeds;
+    for (int i = 0; i < numCPUs; ++i) {
+        double speed;
+        std::cout << "Speed factor for CPU " << i << " (1.0 = reference): ";
+        std::cin >> speed;
+        speeds.push_back(speed);
+    }
+    
+    std::cout << "\nCore placement:" << std::endl;
+    std::cout << "1. By CPU index" << std::endl;
+    std::cout << "2. Fastest core first" << std::endl;
+    std::cout << "3. Shortest job on fastest core" << std::endl;
+    std::cout << "4. Highest priority on fastest core" << std::endl;
+    std::cout << "Choice: ";
+    int placementChoice;
+    std::cin >> placementChoice;
+    
+    printAlgorithmMenu();
+    int algorithmChoice;
+    std::cin >> algorithmChoice;
+    
+    auto scheduler = createScheduler(algorithmChoice, numCPUs);
+    scheduler->setCPUSpeeds(speeds);
+    switch (placementChoice) {
+        case 2: scheduler->setCorePlacement(PLACE_FASTEST_FIRST); break;
+        case 3: scheduler->setCorePlacement(PLACE_SHORTEST_ON_FASTEST); break;
+        case 4: scheduler->setCorePlacement(PLACE_PRIORITY_ON_FASTEST); break;
+        default: scheduler->setCorePlacement(PLACE_BY_INDEX); break;
+    }
+    
+    scheduler->addProcesses(processes);
+    scheduler->run();
+    scheduler->printResults();
+}
+
+void printUsage() {
+    std::cout << "Usage: scheduler                      Interactive menu" << std::endl;
+    std::cout << "       scheduler --stream [options]   Stream arrivals from stdin" << std::endl;
+    std::cout << "       scheduler --compare-trace FILE --cpus N [options]" << std::endl;
+    std::cout << "                                      Replay a Linux sched trace through every policy" << std::endl;
+    std::cout << "       scheduler --validate-solver [--input FILE | --count N] [--cpus N]" << std::endl;
+    std::cout << "                                      Check closed-form schedules against the simulator" << std::endl;
+    std::cout << "       scheduler --compare [--input FILE | --count N] [--cpus N] [--quantum N] [--cache DIR]" << std::endl;
+    std::cout << "                                      Compare the classic policies on one workload" << std::endl;
+    std::cout << "       scheduler --tune-quantum [--input FILE | --count N] [--cpus N] [options]" << std::endl;
+    std::cout << "                                      Search the Round Robin quantum for a workload" << std::endl;
+    std::cout << "       scheduler --generate FILE [--count N] [--seed N] [options]" << std::endl;
+    std::cout << "                                      Write a synthetic workload in the process file format" << std::endl;
+    std::cout << "       scheduler --replicate [--count N] [--cpus N] [options]" << std::endl;
+    std::cout << "                                      Compare policies over seeded workloads with confidence intervals" << std::endl;
+    std::cout << "       scheduler --check-allocations [--input FILE | --count N] [--cpus N]" << std::endl;
+    std::cout << "                                      Verify reruns allocate nothing (needs -DSCHED_COUNT_ALLOCATIONS)" << std::endl;
+    std::cout << "       scheduler --check-cores          Check slow-core and frequency-scaling scenarios" << std::endl;
+    std::cout << "       scheduler --read-trace FILE [--cpu N [--from T] [--to T]]" << std::endl;
+    std::cout << "                                      Summarize a binary trace, or list one CPU's segments" << std::endl;
+    std::cout << "       scheduler --checkpoint FILE --at T [--input FILE | --count N --seed N] [options]" << std::endl;
+    std::cout << "                                      Simulate up to time T and save the run" << std::endl;
+    std::cout << "       scheduler --resume FILE [--at T --checkpoint-to FILE] [same workload and options]" << std::endl;
+    std::cout << "                                      Continue a saved run to the end (or to T) and report it" << std::endl;
+    std::cout << "       scheduler --what-if [--input FILE | --count N] [edits] [options]" << std::endl;
+    std::cout << "                                      Edit a workload and re-simulate only from the last snapshot before the edits" << std::endl;
+    std::cout << "       scheduler --partitioned [--input FILE | --count N] --cpus N [--partitions N] [options]" << std::endl;
+    std::cout << "                                      Simulate a large machine as CPU partitions on worker threads" << std::endl;
+    std::cout << "       scheduler --sweep [--input FILE | --count N --seed N] [grid] [options]" << std::endl;
+    std::cout << "                                      Run a configuration grid as worker processes and merge the results" << std::endl;
+    std::cout << "       scheduler --groups [--input FILE | --count N] [--shares PATH:N,...] [options]" << std::endl;
+    std::cout << "                                      Share CPUs between process groups and report each group" << std::endl;
+    std::cout << "Streaming options:" << std::endl;
+    std::cout << "  --socket PATH      Read arrivals from a Unix socket instead of stdin" << std::endl;
+    std::cout << "  --trace FILE       Read arrivals from a perf sched / ftrace text trace" << std::endl;
+    std::cout << "  --ticks-per-second N  Time units per traced second (default 1000)" << std::endl;
+    std::cout << "  --algorithm N      Algorithm number from the interactive menu (default 1), or all" << std::endl;
+    std::cout << "                     to stream once through the six classic policies and compare them" << std::endl;
+    std::cout << "  --cpus N           Number of CPUs (default 1)" << std::endl;
+    std::cout << "  --quantum N        Time quantum for Round Robin (default 4)" << std::endl;
+    std::cout << "  --tick-ms N        Pace each time unit to N wall-clock milliseconds" << std::endl;
+    std::cout << "  --results FILE     Write each process's results as it retires (.jsonl for JSON Lines)" << std::endl;
+    std::cout << "  --timeseries FILE  Write queue depth and utilization over time as CSV" << std::endl;
+    std::cout << "  --sample-interval N  Ticks per finest time-series bucket (default 1)" << std::endl;
+    std::cout << "  --chrome-trace FILE  Write the schedule as Chrome Trace JSON for Perfetto" << std::endl;
+    std::cout << "  --binary-trace FILE  Write the schedule in the compact binary trace format" << std::endl;
+    std::cout << "Tuning options:" << std::endl;
+    std::cout << "  --objective NAME   mean-response (default), p99-response, turnaround or switches" << std::endl;
+    std::cout << "  --min N, --max N   Quantum range (default 1 to the longest burst)" << std::endl;
+    std::cout << "  --threads N        Simulations run concurrently (default: hardware threads)" << std::endl;
+    std::cout << "  --cache DIR        Reuse results stored in DIR by earlier runs (also for --compare)" << std::endl;
+    std::cout << "Replication options (workload options below also apply):" << std::endl;
+    std::cout << "  --replications N  Maximum replications (default 100)" << std::endl;
+    std::cout << "  --min-replications N  Replications before stopping early (default 5)" << std::endl;
+    std::cout << "  --precision X      Stop once every interval is within X of its mean (default 0.02; 0 = never)" << std::endl;
+    std::cout << "  --metric NAME      wait (default), turnaround, response or utilization" << std::endl;
+    std::cout << "  --confidence X     Confidence level (default 0.95)" << std::endl;
+    std::cout << "  --quantum N        Round Robin quantum (default 4)" << std::endl;
+    std::cout << "  --threads N        Replications run concurrently (default: hardware threads)" << std::endl;
+    std::cout << "  --rate R           Defaults to 80% load on the given CPUs" << std::endl;
+    std::cout << "Workload options (--generate; --seed also fixes --count workloads elsewhere):" << std::endl;
+    std::cout << "  --seed N           Random seed (default 1); equal seeds give equal workloads" << std::endl;
+    std::cout << "  --arrivals MODEL   poisson (default) or mmpp (calm and burst regimes)" << std::endl;
+    std::cout << "  --rate R           Arrivals per time unit (MMPP: calm regime; default 0.5)" << std::endl;
+    std::cout << "  --burst-rate R     MMPP arrivals per time unit in the burst regime (default 4)" << std::endl;
+    std::cout << "  --bursts MODEL     exponential (default), lognormal or pareto" << std::endl;
+    std::cout << "  --mean-burst X     Mean burst time (default 10)" << std::endl;
+    std::cout << "  --shape X          Lognormal sigma or Pareto tail index (default 1, Pareto 2)" << std::endl;
+    std::cout << "  --max-burst N      Cap on burst times (default none)" << std::endl;
+    std::cout << "  --max-priority N   Priorities 0..N (default 10)" << std::endl;
+    std::cout << "  --priority-correlation X  Burst/priority correlation in [-1, 1] (default 0)" << std::endl;
+    std::cout << "  --threads N        Generator threads (default: hardware threads)" << std::endl;
+    std::cout << "What-if options:" << std::endl;
+    std::cout << "  --set-burst ID:B   Change a process's burst time" << std::endl;
+    std::cout << "  --set-priority ID:P  Change a process's priority" << std::endl;
+    std::cout << "  --add FILE         Add the processes in FILE" << std::endl;
+    std::cout << "  --remove ID        Remove a process" << std::endl;
+    std::cout << "  --snapshot-interval N  Ticks between snapshots (default 1000)" << std::endl;
+    std::cout << "Partitioned options (--algorithm and --quantum as for streaming):" << std::endl;
+    std::cout << "  --partitions N     CPU partitions, each with its own run queue (default: one per CPU)" << std::endl;
+    std::cout << "  --window N         Ticks partitions run between placing arrivals (default 64)" << std::endl;
+    std::cout << "  --threads N        Worker threads (default: hardware threads); results do not depend on it" << std::endl;
+    std::cout << "Sweep options:" << std::endl;
+    std::cout << "  --algorithms LIST  Comma-separated algorithm numbers (default 1,2,3,4,5,6)" << std::endl;
+    std::cout << "  --cpus LIST        CPU counts (default 1)" << std::endl;
+    std::cout << "  --quanta LIST      Quanta for the time-sliced policies (default 4)" << std::endl;
+    std::cout << "  --shards N         Worker processes the grid is split into (default 4)" << std::endl;
+    std::cout << "  --dir DIR          Directory for shard results (default sweep)" << std::endl;
+    std::cout << "  --workers N        Shards run at a time (default: hardware threads)" << std::endl;
+    std::cout << "  --command TEMPLATE Command that runs one shard; {args} becomes the worker's arguments and" << std::endl;
+    std::cout << "                     {shard} its number (default: this program with {args})" << std::endl;
+    std::cout << "Group options (--cpus and --quantum as for streaming):" << std::endl;
+    std::cout << "  --algorithm N      Policy inside each group: 1 FCFS (default), 2 or 3 SJF, 4 Round Robin," << std::endl;
+    std::cout << "                     5 or 6 Priority" << std::endl;
+    std::cout << "  --shares LIST      Group shares, e.g. /web:2048,/batch:512 (default 1024, at most 262144)" << std::endl;
+    std::cout << "  --assign LIST      Put ungrouped processes into these groups in turn, e.g. /web,/batch" << std::endl;
+}
+
+// Streaming mode: one process per line in the process file format, consumed as
+// simulated time advances; completed processes are folded into the totals
+// "--key value" pairs following the mode argument
+std::map<std::string, std::string> parseOptions(int argc, char* argv[], int first) {
+    std::map<std::string, std::string> options;
+    for (int i = first; i < argc; i += 2) {
+        std::string key = argv[i];
+        if (key.compare(0, 2, "--") != 0 || i + 1 >= argc) {
+            throw std::invalid_argument("Expected --option value, got " + key);
+        }
+        options[key] = argv[i + 1];
+    }
+    return options;
+}
+
+int optionInt(const std::map<std::string, std::string>& options, const std::string& key, int fallback) {
+    auto it = options.find(key);
+    return it == options.end() ? fallback : std::stoi(it->second);
+}
+
+double optionDouble(const std::map<std::string, std::string>& options, const std::string& key, double fallback) {
+    auto it = options.find(key);
+    return it == options.end() ? fallback : std::stod(it->second);
+}
+
+TraceImportOptions traceOptions(const std::map<std::string, std::string>& options) {
+    TraceImportOptions importOptions;
+    auto it = options.find("--ticks-per-second");
+    if (it != options.end()) {
+        importOptions.ticksPerSecond = std::stod(it->second);
+    }
+    return importOptions;
+}
+
+// Streams the arrivals once through all six classic policies in lock-step
+std::vector<std::unique_ptr<Scheduler>> compareStreamed(ArrivalStream& stream, int numCPUs, int quantum,
+                                                        int tickMillis = 0) {
+    std::vector<std::unique_ptr<Scheduler>> schedulers;
+    FusedSimulation fused;
+    for (int algorithmChoice = 1; algorithmChoice <= 6; ++algorithmChoice) {
+        schedulers.push_back(createScheduler(algorithmChoice, numCPUs, quantum));
+        fused.addScheduler(*schedulers.back());
+    }
+    fused.run(stream, tickMillis);
+    return schedulers;
+}
+
+void printStreamedComparison(const std::vector<std::unique_ptr<Scheduler>>& schedulers,
+                             const ObservedSummary* observed = nullptr) {
+    std::vector<std::string> names;
+    std::vector<double> avgWaitingTimes, avgTurnaroundTimes, avgResponseTimes, cpuUtilizations;
+    for (const auto& scheduler : schedulers) {
+        names.push_back(scheduler->getAlgorithmName());
+        avgWaitingTimes.push_back(scheduler->calculateAverageWaitingTime());
+        avgTurnaroundTimes.push_back(scheduler->calculateAverageTurnaroundTime());
+        avgResponseTimes.push_back(scheduler->calculateAverageResponseTime());
+        cpuUtilizations.push_back(scheduler->calculateAverageCPUUtilization());
+    }
+    if (observed) {
+        names.push_back("Linux (observed)");
+        avgWaitingTimes.push_back(observed->averageWaitingTime());
+        avgTurnaroundTimes.push_back(observed->averageTurnaroundTime());
+        avgResponseTimes.push_back(observed->averageResponseTime());
+        cpuUtilizations.push_back(observed->cpuUtilization());
+    }
+    Statistics::printComparisonTable(names, avgWaitingTimes, avgTurnaroundTimes,
+                                     avgResponseTimes, cpuUtilizations);
+}
+
+// --stream --algorithm all: every classic policy over one pass of the input
+int runStreamingComparison(std::map<std::string, std::string>& options, int tickMillis) {
+    for (const char* option : {"--results", "--timeseries", "--chrome-trace", "--binary-trace"}) {
+        if (options.count(option)) {
+            throw std::invalid_argument(std::string(option) + " needs a single --algorithm");
+        }
+    }
+    int numCPUs = optionInt(options, "--cpus", 1);
+    int quantum = optionInt(options, "--quantum", 4);
+    
+    std::vector<std::unique_ptr<Scheduler>> schedulers;
+    if (options.count("--socket")) {
+        std::cout << "Waiting for producer on " << options["--socket"] << std::endl;
+        UnixSocketArrivalStream stream(options["--socket"]);
+        schedulers = compareStreamed(stream, numCPUs, quantum, tickMillis);
+    } else if (options.count("--trace")) {
+        std::ifstream file(options["--trace"], std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not open file " + options["--trace"]);
+        }
+        LinuxTraceArrivalStream stream(file, traceOptions(options));
+        schedulers = compareStreamed(stream, numCPUs, quantum, tickMillis);
+    } else {
+        TextArrivalStream stream(std::cin);
+        schedulers = compareStreamed(stream, numCPUs, quantum, tickMillis);
+    }
+    
+    std::cout << "\nStreamed once through " << schedulers.size() << " policies" << std::endl;
+    printStreamedComparison(schedulers);
+    return 0;
+}
+
+int runStreamingMode(int argc, char* argv[]) {
+    auto options = parseOptions(argc, argv, 2);
+    int tickMillis = optionInt(options, "--tick-ms", 0);
+    if (options.count("--algorithm") && options["--algorithm"] == "all") {
+        return runStreamingComparison(options, tickMillis);
+    }
+    
+    auto scheduler = createScheduler(optionInt(options, "--algorithm", 1),
+                                     optionInt(options, "--cpus", 1),
+                                     optionInt(options, "--quantum", 4));
+    
+    // A paced run must not stall on the disk; an unpaced one is faster without
+    // a second thread (see AsyncWriter)
+    std::unique_ptr<ResultsFileWriter> results;
+    if (options.count("--results")) {
+        bool realTime = tickMillis > 0 || options.count("--socket");
+        results = std::make_unique<ResultsFileWriter>(options["--results"],
+                                                      scheduler->getAlgorithmName(), realTime);
+        if (!results->isOpen()) {
+            throw std::runtime_error("Could not open file " + options["--results"]);
+        }
+        scheduler->setRetirementSink(results.get());
+    }
+    
+    std::unique_ptr<TimeSeriesSampler> sampler;
+    if (options.count("--timeseries")) {
+        sampler = std::make_unique<TimeSeriesSampler>(scheduler->getNumCPUs(),
+                                                      optionInt(options, "--sample-interval", 1));
+        scheduler->setSampler(sampler.get());
+    }
+    
+    std::unique_ptr<ChromeTraceWriter> chromeTrace;
+    if (options.count("--chrome-trace")) {
+        chromeTrace = std::make_unique<ChromeTraceWriter>(options["--chrome-trace"]);
+        if (!chromeTrace->isOpen()) {
+            throw std::runtime_error("Could not open file " + options["--chrome-trace"]);
+        }
+        scheduler->addObserver(chromeTrace.get());
+    }
+    
+    std::unique_ptr<BinaryTraceWriter> binaryTrace;
+    if (options.count("--binary-trace")) {
+        binaryTrace = std::make_unique<BinaryTraceWriter>(options["--binary-trace"]);
+        if (!binaryTrace->isOpen()) {
+            throw std::runtime_error("Could not open file " + options["--binary-trace"]);
+        }
+        scheduler->addObserver(binaryTrace.get());
+    }
+    
+    if (options.count("--socket")) {
+        std::cout << "Waiting for producer on " << options["--socket"] << std::endl;
+        UnixSocketArrivalStream stream(options["--socket"]);
+        scheduler->runStreaming(stream, tickMillis);
+    } else if (options.count("--trace")) {
+        std::ifstream file(options["--trace"], std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not open file " + options["--trace"]);
+        }
+        LinuxTraceArrivalStream stream(file, traceOptions(options));
+        scheduler->runStreaming(stream, tickMillis);
+    } else {
+        TextArrivalStream stream(std::cin);
+        scheduler->runStreaming(stream, tickMillis);
+    }
+    scheduler->printStatistics();
+    
+    if (results) {
+        if (!results->close()) {
+            throw std::runtime_error("Could not write file " + options["--results"]);
+        }
+        std::cout << results->getRecordCount() << " results saved to " << options["--results"] << std::endl;
+    }
+    if (sampler) {
+        if (!sampler->saveToCSV(options["--timeseries"])) {
+            throw std::runtime_error("Could not write file " + options["--timeseries"]);
+        }
+        std::cout << "Time series saved to " << options["--timeseries"] << std::endl;
+    }
+    if (chromeTrace) {
+        if (!chromeTrace->close()) {
+            throw std::runtime_error("Could not write file " + options["--chrome-trace"]);
+        }
+        std::cout << "Chrome trace saved to " << options["--chrome-trace"] << std::endl;
+    }
+    if (binaryTrace) {
+        if (!binaryTrace->close()) {
+            throw std::runtime_error("Could not write file " + options["--binary-trace"]);
+        }
+        std::cout << "Binary trace saved to " << options["--binary-trace"]
+                  << " (" << binaryTrace->getBytesWritten() << " bytes)" << std::endl;
+    }
+    return 0;
+}
+
+// Replays the bursts found in a kernel trace through every policy and puts
+// what the kernel actually achieved next to them. The trace is streamed once,
+// through all policies together, so its size is not limited by memory.
+int runTraceComparison(int argc, char* argv[]) {
+    if (argc < 3) {
+        printUsage();
+        return 1;
+    }
+    std::string tracePath = argv[2];
+    auto options = parseOptions(argc, argv, 3);
+    if (!options.count("--cpus")) {
+        throw std::invalid_argument("--compare-trace needs --cpus to match the traced machine");
+    }
+    int numCPUs = optionInt(options, "--cpus", 1);
+    int quantum = optionInt(options, "--quantum", 4);
+    
+    std::ifstream file(tracePath, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open file " + tracePath);
+    }
+    LinuxTraceArrivalStream stream(file, traceOptions(options));
+    auto schedulers = compareStreamed(stream, numCPUs, quantum);
+    ObservedSummary observed = stream.getImporter().getObservedSummary();
+    
+    std::cout << "\nTrace: " << observed.bursts << " bursts on " << observed.cpuCount
+              << " traced CPUs over " << observed.spanTicks << " time units" << std::endl;
+    printStreamedComparison(schedulers, &observed);
+    return 0;
+}
+
+// Whether workloadOption builds the same workload every time: a file, or a
+// fixed seed (seed 0 seeds from the clock)
+bool repeatableWorkload(std::map<std::string, std::string>& options) {
+    return options.count("--input") || (options.count("--seed") && std::stoull(options["--seed"]) != 0);
+}
+
+// Workload from --input FILE, or --count random processes
+std::vector<std::shared_ptr<Process>> workloadOption(std::map<std::string, std::string>& options,
+                                                     int numCPUs) {
+    if (options.count("--input")) {
+        return InputGenerator::loadFromFile(options["--input"]);
+    }
+    int count = optionInt(options, "--count", 10000);
+    unsigned long long seed = options.count("--seed") ? std::stoull(options["--seed"]) : 0;
+    return InputGenerator::generateRandomProcesses(count, count * 10 / numCPUs, 20, 10, seed);
+}
+
+// Workload model from the generator options; see printUsage
+WorkloadSpec workloadSpecOption(std::map<std::string, std::string>& options) {
+    WorkloadSpec spec;
+    spec.count = options.count("--count") ? std::stoll(options["--count"]) : spec.count;
+    spec.seed = options.count("--seed") ? std::stoull(options["--seed"]) : spec.seed;
+    spec.threads = optionInt(options, "--threads", 0);
+    
+    std::string arrivals = options.count("--arrivals") ? options["--arrivals"] : "poisson";
+    if (arrivals == "mmpp") {
+        spec.arrivals = ARRIVALS_MMPP;
+    } else if (arrivals != "poisson") {
+        throw std::invalid_argument("Unknown arrival model " + arrivals);
+    }
+    spec.arrivalRate = optionDouble(options, "--rate", spec.arrivalRate);
+    spec.burstArrivalRate = optionDouble(options, "--burst-rate", spec.burstArrivalRate);
+    
+    std::string bursts = options.count("--bursts") ? options["--bursts"] : "exponential";
+    if (bursts == "lognormal") {
+        spec.bursts = BURSTS_LOGNORMAL;
+    } else if (bursts == "pareto") {
+        spec.bursts = BURSTS_PARETO;
+        spec.burstShape = 2.0;
+    } else if (bursts != "exponential") {
+        throw std::invalid_argument("Unknown burst model " + bursts);
+    }
+    spec.meanBurst = optionDouble(options, "--mean-burst", spec.meanBurst);
+    spec.burstShape = optionDouble(options, "--shape", spec.burstShape);
+    spec.maxBurst = optionInt(options, "--max-burst", spec.maxBurst);
+    spec.maxPriority = optionInt(options, "--max-priority", spec.maxPriority);
+    spec.priorityCorrelation = optionDouble(options, "--priority-correlation", spec.priorityCorrelation);
+    return spec;
+}
+
+// Writes a seeded synthetic workload; the same options always give the same file
+int runWorkloadGeneration(int argc, char* argv[]) {
+    if (argc < 3) {
+        printUsage();
+        return 1;
+    }
+    std::string filename = argv[2];
+    auto options = parseOptions(argc, argv, 3);
+    WorkloadSpec spec = workloadSpecOption(options);
+    
+    auto start = std::chrono::steady_clock::now();
+    SyntheticWorkload workload = WorkloadGenerator::generate(spec);
+    auto generated = std::chrono::steady_clock::now();
+    if (!workload.saveToFile(filename)) {
+        throw std::runtime_error("Could not write file " + filename);
+    }
+    auto saved = std::chrono::steady_clock::now();
+    
+    std::cout << workload.size() << " processes generated in " << std::fixed << std::setprecision(2)
+              << std::chrono::duration<double, std::milli>(generated - start).count() << " ms, saved to "
+              << filename << " in " << std::chrono::duration<double, std::milli>(saved - generated).count()
+              << " ms" << std::endl;
+    return 0;
+}
+
+// Solves each non-preemptive policy in closed form and by simulation, and
+// reports whether they agree and how long each took
+int runSolverValidation(int argc, char* argv[]) {
+    auto options = parseOptions(argc, argv, 2);
+    int numCPUs = optionInt(options, "--cpus", 4);
+    
+    auto processes = workloadOption(options, numCPUs);
+    auto workload = std::make_shared<const Workload>(processes);
+    
+    const int choices[] = {1, 2, 5};   // FCFS, SJF, Non-preemptive Priority
+    int failures = 0;
+    std::vector<std::string> report;
+    for (int choice : choices) {
+        auto scheduler = createScheduler(choice, numCPUs);
+        scheduler->setWorkload(workload);
+        // FCFS sorts its processes in schedule(); solve in the order run() will use
+        scheduler->schedule();
+        
+        auto solveStart = std::chrono::steady_clock::now();
+        AnalyticSchedule solved = AnalyticSolver::solve(*scheduler);
+        auto solveEnd = std::chrono::steady_clock::now();
+        scheduler->setSolverMode(SOLVE_SIMULATE);
+        scheduler->run();
+        auto simulateEnd = std::chrono::steady_clock::now();
+        
+        int mismatches = AnalyticSolver::compare(*scheduler, solved);
+        failures += mismatches > 0;
+        
+        std::ostringstream line;
+        line << std::left << std::setw(34) << scheduler->getAlgorithmName()
+             << std::fixed << std::setprecision(2)
+             << std::setw(16) << std::chrono::duration<double, std::milli>(solveEnd - solveStart).count()
+             << std::setw(16) << std::chrono::duration<double, std::milli>(simulateEnd - solveEnd).count()
+             << (mismatches == 0 ? "match" : std::to_string(mismatches) + " mismatches");
+        report.push_back(line.str());
+    }
+    
+    std::cout << "\n" << processes.size() << " processes on " << numCPUs << " CPU(s)" << std::endl;
+    std::cout << std::left << std::setw(34) << "Algorithm" << std::setw(16) << "Closed form ms"
+              << std::setw(16) << "Simulated ms" << "Result" << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+    for (const auto& line : report) {
+        std::cout << line << std::endl;
+    }
+    return failures == 0 ? 0 : 1;
+}
+
+int runQuantumTuning(int argc, char* argv[]) {
+    auto options = parseOptions(argc, argv, 2);
+    int numCPUs = optionInt(options, "--cpus", 1);
+    auto processes = workloadOption(options, numCPUs);
+    
+    const std::map<std::string, TuningObjective> objectives = {
+        {"mean-response", TUNE_MEAN_RESPONSE}, {"p99-response", TUNE_P99_RESPONSE},
+        {"turnaround", TUNE_MEAN_TURNAROUND}, {"switches", TUNE_CONTEXT_SWITCHES}};
+    TuningObjective objective = TUNE_MEAN_RESPONSE;
+    if (options.count("--objective")) {
+        auto it = objectives.find(options["--objective"]);
+        if (it == objectives.end()) {
+            throw std::invalid_argument("Unknown objective " + options["--objective"]);
+        }
+        objective = it->second;
+    }
+    
+    QuantumTuner tuner(processes, numCPUs, objective);
+    if (options.count("--min") || options.count("--max")) {
+        int longestBurst = 1;
+        for (const auto& process : processes) {
+            longestBurst = std::max(longestBurst, process->getBurstTime());
+        }
+        tuner.setRange(optionInt(options, "--min", 1), optionInt(options, "--max", longestBurst));
+    }
+    if (options.count("--threads")) {
+        tuner.setThreads(optionInt(options, "--threads", 1));
+    }
+    std::unique_ptr<ResultCache> cache;
+    if (options.count("--cache")) {
+        cache = std::make_unique<ResultCache>(options["--cache"]);
+        tuner.setResultCache(cache.get());
+    }
+    
+    std::cout << "Tuning Round Robin for " << processes.size() << " processes on "
+              << numCPUs << " CPU(s)" << std::endl;
+    QuantumTuner::printResult(tuner.tune(), objective);
+    if (cache) {
+        std::cout << "Result cache: " << cache->getHits() << " runs reused, "
+                  << cache->getMisses() << " simulated" << std::endl;
+    }
+    return 0;
+}
+
+// The six classic policies side by side on one workload, optionally reusing
+// results cached on disk by earlier identical runs
+int runComparison(int argc, char* argv[]) {
+    auto options = parseOptions(argc, argv, 2);
+    int numCPUs = optionInt(options, "--cpus", 1);
+    int quantum = std::max(1, optionInt(options, "--quantum", 4));
+    auto processes = workloadOption(options, numCPUs);
+    
+    std::unique_ptr<ResultCache> cache;
+    if (options.count("--cache")) {
+        cache = std::make_unique<ResultCache>(options["--cache"]);
+    }
+    compareWorkload(processes, numCPUs, quantum, cache.get());
+    if (cache) {
+        std::cout << "Result cache: " << cache->getHits() << " runs reused, "
+                  << cache->getMisses() << " simulated" << std::endl;
+    }
+    return 0;
+}
+
+// Puts processes without a group into the comma-separated group paths in turn
+void assignGroups(const std::vector<std::shared_ptr<Process>>& processes, const std::string& list) {
+    std::vector<std::string> paths;
+    std::istringstream items(list);
+    std::string path;
+    while (std::getline(items, path, ',')) {
+        paths.push_back(path);
+    }
+    size_t next = 0;
+    for (const auto& process : processes) {
+        if (process->getGroup().empty() && !paths.empty()) {
+            process->setGroup(paths[next++ % paths.size()]);
+        }
+    }
+}
+
+// Runs every policy twice on one workload and reports the heap allocations of
+// each tick loop. The first run sizes queues and histories; after reset() the
+// second must not allocate at all. Ungrouped processes are spread over a small
+// group tree for the group scheduler; the other policies ignore groups.
+int runAllocationCheck(int argc, char* argv[]) {
+    if (!AllocationCounter::enabled()) {
+        std::cerr << "Allocation counting is not compiled in; rebuild with -DSCHED_COUNT_ALLOCATIONS" << std::endl;
+        return 1;
+    }
+    auto options = parseOptions(argc, argv, 2);
+    int numCPUs = optionInt(options, "--cpus", 4);
+    auto processes = workloadOption(options, numCPUs);
+    assignGroups(processes, "/a/x,/a/y,/b");
+    auto workload = std::make_shared<const Workload>(processes);
+    
+    std::vector<std::unique_ptr<Scheduler>> schedulers;
+    for (int choice = 1; choice <= 9; ++choice) {
+        schedulers.push_back(createScheduler(choice, numCPUs, 4));
+    }
+    schedulers.push_back(std::make_unique<GroupScheduler>(numCPUs, INNER_ROUND_ROBIN, 4));
+    
+    int failures = 0;
+    std::cout << std::left << std::setw(37) << "Algorithm" << std::setw(20) << "First run allocs"
+              << "Rerun allocs" << std::endl;
+    std::cout << std::string(73, '-') << std::endl;
+    for (auto& scheduler : schedulers) {
+        scheduler->setQuiet(true);
+        scheduler->setSolverMode(SOLVE_SIMULATE);
+        scheduler->setWorkload(workload);
+        scheduler->run();
+        long long firstRun = scheduler->getLoopAllocations();
+        scheduler->reset();
+        scheduler->run();
+        long long rerun = scheduler->getLoopAllocations();
+        failures += rerun != 0;
+        
+        std::cout << std::left << std::setw(37) << scheduler->getAlgorithmName()
+                  << std::setw(20) << firstRun << rerun << std::endl;
+    }
+    return failures == 0 ? 0 : 1;
+}
+
+// Small heterogeneous-core scenarios with known makespans: slow cores must
+// keep fractional progress across preemptions, and an idle-downclocking core
+// redispatched in the same tick must not pay a frequency transition
+int runCoreCheck(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+    struct CoreCase {
+        std::string name;
+        std::function<std::unique_ptr<Scheduler>()> build;
+        std::vector<int> bursts;
+        int expectedMakespan;
+    };
+    const std::vector<CoreCase> cases = {
+        {"RR q=1 on a 0.5 core", [] {
+            auto scheduler = std::make_unique<RoundRobin>(1, 1);
+            scheduler->setCPUSpeeds({0.5});
+            return std::unique_ptr<Scheduler>(std::move(scheduler));
+        }, {3, 3}, 12},
+        {"RR q=1 on a 0.3 core", [] {
+            auto scheduler = std::make_unique<RoundRobin>(1, 1);
+            scheduler->setCPUSpeeds({0.3});
+            return std::unique_ptr<Scheduler>(std::move(scheduler));
+        }, {2, 2, 2}, 21},
+        {"RR q=2, idle downclock, latency 3", [] {
+            auto scheduler = std::make_unique<RoundRobin>(2, 1);
+            scheduler->setCPUFrequencyLevels({0.5, 1.0}, 3, true);
+            return std::unique_ptr<Scheduler>(std::move(scheduler));
+        }, {5, 5}, 13},
+    };
+    
+    int failures = 0;
+    std::cout << std::left << std::setw(38) << "Scenario" << std::setw(12) << "Expected"
+              << std::setw(12) << "Makespan" << "Result" << std::endl;
+    std::cout << std::string(70, '-') << std::endl;
+    for (const auto& check : cases) {
+        auto scheduler = check.build();
+        scheduler->setQuiet(true);
+        std::vector<std::shared_ptr<Process>> processes;
+        for (size_t i = 0; i < check.bursts.size(); ++i) {
+            processes.push_back(std::make_shared<Process>(static_cast<int>(i) + 1, 0, check.bursts[i]));
+        }
+        scheduler->addProcesses(processes);
+        
+        bool finished = scheduler->runUntil(10000);
+        int makespan = 0;
+        for (const auto& process : scheduler->getProcesses()) {
+            makespan = std::max(makespan, process->getCompletionTime());
+        }
+        bool passed = finished && makespan == check.expectedMakespan;
+        failures += !passed;
+        
+        std::cout << std::left << std::setw(38) << check.name << std::setw(12) << check.expectedMakespan
+                  << std::setw(12) << (finished ? std::to_string(makespan) : "unfinished")
+                  << (passed ? "pass" : "FAIL") << std::endl;
+    }
+    return failures == 0 ? 0 : 1;
+}
+
+// Reads a binary trace back: totals per CPU, or the segments of one CPU in a
+// time range, decoding only the blocks that range touches
+int runTraceReading(int argc, char* argv[]) {
+    if (argc < 3) {
+        printUsage();
+        return 1;
+    }
+    BinaryTraceReader reader(argv[2]);
+    auto options = parseOptions(argc, argv, 3);
+    if (!reader.hasIndex()) {
+        std::cout << "Trace has no index (writer did not finish); recovered "
+                  << reader.getBlocks().size() << " blocks" << std::endl;
+    }
+    
+    if (options.count("--cpu")) {
+        int cpu = optionInt(options, "--cpu", 0);
+        int from = optionInt(options, "--from", 0);
+        int to = optionInt(options, "--to", std::numeric_limits<int>::max());
+        std::cout << std::left << std::setw(10) << "Start" << std::setw(10) << "End"
+                  << std::setw(15) << "Process" << "Outcome" << std::endl;
+        std::cout << std::string(45, '-') << std::endl;
+        reader.forEachSegment(cpu, from, to, [&](const TraceSegment& segment) {
+            std::cout << std::left << std::setw(10) << segment.start << std::setw(10) << segment.end
+                      << std::setw(15) << reader.getProcessName(segment.processID)
+                      << (segment.completed ? "completed" : "preempted") << std::endl;
+        });
+        return 0;
+    }
+    
+    std::vector<long long> segments(reader.getCPUCount()), busy(reader.getCPUCount()),
+                           preemptions(reader.getCPUCount());
+    std::vector<int> lastEnd(reader.getCPUCount());
+    TraceSegment segment;
+    while (reader.next(segment)) {
+        if (segment.cpu < 0 || segment.cpu >= reader.getCPUCount()) continue;
+        segments[segment.cpu]++;
+        busy[segment.cpu] += segment.end - segment.start;
+        preemptions[segment.cpu] += !segment.completed;
+        lastEnd[segment.cpu] = std::max(lastEnd[segment.cpu], segment.end);
+    }
+    
+    std::cout << std::left << std::setw(8) << "CPU" << std::setw(14) << "Segments"
+              << std::setw(14) << "Busy time" << std::setw(14) << "Preemptions" << "Last end" << std::endl;
+    std::cout << std::string(60, '-') << std::endl;
+    for (int cpu = 0; cpu < reader.getCPUCount(); ++cpu) {
+        std::cout << std::left << std::setw(8) << cpu << std::setw(14) << segments[cpu]
+                  << std::setw(14) << busy[cpu] << std::setw(14) << preemptions[cpu] << lastEnd[cpu] << std::endl;
+    }
+    return 0;
+}
+
+// Stops a run part-way and saves it, or picks a saved run up again. Resuming
+// rebuilds the scheduler from the same options, so a checkpoint can also be
+// continued to several later points as separate what-if branches.
+int runCheckpointing(int argc, char* argv[]) {
+    if (argc < 3) {
+        printUsage();
+        return 1;
+    }
+    bool resuming = std::string(argv[1]) == "--resume";
+    std::string path = argv[2];
+    auto options = parseOptions(argc, argv, 3);
+    if (!repeatableWorkload(options)) {
+        throw std::invalid_argument("Checkpoints need --input or a non-zero --seed so the workload can be rebuilt");
+    }
+    int numCPUs = optionInt(options, "--cpus", 1);
+    int quantum = std::max(1, optionInt(options, "--quantum", 4));
+    auto scheduler = createScheduler(optionInt(options, "--algorithm", 1), numCPUs, quantum);
+    scheduler->setQuiet(true);
+    scheduler->setWorkload(std::make_shared<const Workload>(workloadOption(options, numCPUs)));
+    
+    std::string target = path;
+    int stopTime = std::numeric_limits<int>::max();
+    if (resuming) {
+        scheduler->restoreCheckpoint(path);
+        std::cout << "Resumed " << scheduler->getAlgorithmName() << " at time "
+                  << scheduler->getCurrentTime() << std::endl;
+        if (options.count("--at")) {
+            stopTime = optionInt(options, "--at", 0);
+            target = options.count("--checkpoint-to") ? options["--checkpoint-to"] : path;
+        }
+    } else {
+        if (!options.count("--at")) {
+            throw std::invalid_argument("--checkpoint needs --at");
+        }
+        stopTime = optionInt(options, "--at", 0);
+    }
+    
+    if (scheduler->runUntil(stopTime)) {
+        std::cout << "Simulation completed at time " << scheduler->getCurrentTime() << std::endl;
+        scheduler->printStatistics();
+        return 0;
+    }
+    scheduler->saveCheckpoint(target);
+    std::cout << "Checkpoint of " << scheduler->getAlgorithmName() << " at time "
+              << scheduler->getCurrentTime() << " saved to " << target << std::endl;
+    return 0;
+}
+
+// "ID:VALUE" from a what-if option
+std::pair<int, int> editOption(const std::string& text) {
+    size_t colon = text.find(':');
+    if (colon == std::string::npos) {
+        throw std::invalid_argument("Expected ID:VALUE, got " + text);
+    }
+    return {std::stoi(text.substr(0, colon)), std::stoi(text.substr(colon + 1))};
+}
+
+// Simulates a workload, applies the edits and simulates again from the last
+// snapshot before the earliest edited arrival, then compares the two runs
+int runWhatIf(int argc, char* argv[]) {
+    auto options = parseOptions(argc, argv, 2);
+    int numCPUs = optionInt(options, "--cpus", 1);
+    int quantum = std::max(1, optionInt(options, "--quantum", 4));
+    int algorithmChoice = optionInt(options, "--algorithm", 1);
+    IncrementalSimulator simulator([=]() { return createScheduler(algorithmChoice, numCPUs, quantum); },
+                                   workloadOption(options, numCPUs),
+                                   optionInt(options, "--snapshot-interval", 1000));
+    
+    std::vector<std::string> names;
+    std::vector<double> avgWaitingTimes, avgTurnaroundTimes, avgResponseTimes, cpuUtilizations;
+    auto record = [&](const std::string& name, const Scheduler& scheduler) {
+        names.push_back(name);
+        avgWaitingTimes.push_back(scheduler.calculateAverageWaitingTime());
+        avgTurnaroundTimes.push_back(scheduler.calculateAverageTurnaroundTime());
+        avgResponseTimes.push_back(scheduler.calculateAverageResponseTime());
+        cpuUtilizations.push_back(scheduler.calculateAverageCPUUtilization());
+    };
+    record("Baseline", simulator.run());
+    long long baselineTicks = simulator.getSimulatedTicks();
+    
+    if (options.count("--set-burst")) {
+        auto edit = editOption(options["--set-burst"]);
+        simulator.setBurstTime(edit.first, edit.second);
+    }
+    if (options.count("--set-priority")) {
+        auto edit = editOption(options["--set-priority"]);
+        simulator.setPriority(edit.first, edit.second);
+    }
+    if (options.count("--add")) {
+        for (const auto& process : InputGenerator::loadFromFile(options["--add"])) {
+            simulator.addProcess(*process);
+        }
+    }
+    if (options.count("--remove")) {
+        simulator.removeProcess(optionInt(options, "--remove", 0));
+    }
+    record("Edited", simulator.rerun());
+    
+    std::cout << simulator.getScheduler().getAlgorithmName() << ": re-simulated from time "
+              << simulator.getResumeTime() << ", " << simulator.getSimulatedTicks() << " of "
+              << baselineTicks << " ticks" << std::endl;
+    Statistics::printComparisonTable(names, avgWaitingTimes, avgTurnaroundTimes,
+                                     avgResponseTimes, cpuUtilizations);
+    return 0;
+}
+
+// Compares the six classic policies over independently seeded workloads and
+// reports confidence intervals instead of single-run numbers
+int runReplications(int argc, char* argv[]) {
+    auto options = parseOptions(argc, argv, 2);
+    int numCPUs = optionInt(options, "--cpus", 1);
+    int quantum = std::max(1, optionInt(options, "--quantum", 4));   // never prompt from a worker
+    
+    WorkloadSpec spec = workloadSpecOption(options);
+    if (!options.count("--rate")) {
+        // 80% offered load keeps queues finite whatever the CPU count
+        spec.arrivalRate = 0.8 * numCPUs / spec.meanBurst;
+    }
+    
+    const std::map<std::string, ReplicationMetric> metrics = {
+        {"wait", METRIC_WAITING}, {"turnaround", METRIC_TURNAROUND},
+        {"response", METRIC_RESPONSE}, {"utilization", METRIC_UTILIZATION}};
+    ReplicationMetric metric = METRIC_WAITING;
+    if (options.count("--metric")) {
+        auto it = metrics.find(options["--metric"]);
+        if (it == metrics.end()) {
+            throw std::invalid_argument("Unknown metric " + options["--metric"]);
+        }
+        metric = it->second;
+    }
+    
+    ReplicationRunner runner(spec);
+    for (int choice = 1; choice <= 6; ++choice) {
+        std::string name = createScheduler(choice, numCPUs, quantum)->getAlgorithmName();
+        runner.addConfiguration(name, [=]() { return createScheduler(choice, numCPUs, quantum); });
+    }
+    runner.setReplications(optionInt(options, "--min-replications", 5), optionInt(options, "--replications", 100));
+    runner.setPrecision(optionDouble(options, "--precision", 0.02), metric);
+    runner.setConfidence(optionDouble(options, "--confidence", 0.95));
+    if (options.count("--threads")) {
+        runner.setThreads(optionInt(options, "--threads", 1));
+    }
+    
+    std::cout << "Replicating " << spec.count << " processes per workload on " << numCPUs << " CPU(s)" << std::endl;
+    Statistics::printReplicationTable(runner.run());
+    return 0;
+}
+
+// One policy over many CPUs split into partitions with their own run queues,
+// simulated window by window on worker threads
+int runPartitioned(int argc, char* argv[]) {
+    auto options = parseOptions(argc, argv, 2);
+    int numCPUs = optionInt(options, "--cpus", 1);
+    int algorithmChoice = optionInt(options, "--algorithm", 1);
+    int quantum = std::max(1, optionInt(options, "--quantum", 4));   // never prompt from a worker
+    auto processes = workloadOption(options, numCPUs);
+    
+    PartitionedSimulation simulation(
+        [=](int cpus) { return createScheduler(algorithmChoice, cpus, quantum); },
+        numCPUs, optionInt(options, "--partitions", numCPUs), optionInt(options, "--window", 64));
+    if (options.count("--threads")) {
+        simulation.setThreads(optionInt(options, "--threads", 1));
+    }
+    simulation.addProcesses(processes);
+    
+    auto start = std::chrono::steady_clock::now();
+    simulation.run();
+    auto end = std::chrono::steady_clock::now();
+    
+    const auto& partitions = simulation.getPartitions();
+    std::cout << partitions.front()->getAlgorithmName() << ": " << processes.size() << " processes on "
+              << numCPUs << " CPU(s) in " << partitions.size() << " partition(s)" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Completed at time " << simulation.getEndTime() << " after "
+              << simulation.getWindowCount() << " windows" << std::endl;
+    std::cout << "Average Waiting Time: " << simulation.calculateAverageWaitingTime() << std::endl;
+    std::cout << "Average Turnaround Time: " << simulation.calculateAverageTurnaroundTime() << std::endl;
+    std::cout << "Average Response Time: " << simulation.calculateAverageResponseTime() << std::endl;
+    std::cout << "CPU Utilization: " << simulation.calculateAverageCPUUtilization() << "%" << std::endl;
+    std::cerr << "Simulated in " << std::chrono::duration<double, std::milli>(end - start).count()
+              << " ms" << std::endl;
+    return 0;
+}
+
+// Comma-separated integers, e.g. "1,2,4"
+std::vector<int> optionList(const std::map<std::string, std::string>& options, const std::string& key,
+                            const std::vector<int>& fallback) {
+    auto it = options.find(key);
+    if (it == options.end()) return fallback;
+    
+    std::vector<int> values;
+    std::istringstream list(it->second);
+    std::string item;
+    while (std::getline(list, item, ',')) {
+        values.push_back(std::stoi(item));
+    }
+    if (values.empty()) {
+        throw std::invalid_argument("Expected a comma-separated list for " + key);
+    }
+    return values;
+}
+
+// The grid every sweep process builds from the same options: algorithms x CPU
+// counts x quanta, the quanta only for the policies that use one. The workload
+// is generated for the largest CPU count, so it is the same for every point.
+std::unique_ptr<SweepRunner> sweepOption(std::map<std::string, std::string>& options) {
+    if (!repeatableWorkload(options)) {
+        throw std::invalid_argument("Sweeps need --input or a non-zero --seed so every worker builds the same workload");
+    }
+    auto sweep = std::make_unique<SweepRunner>(options.count("--dir") ? options["--dir"] : "sweep",
+                                               optionInt(options, "--shards", 4));
+    std::vector<int> cpuCounts = optionList(options, "--cpus", {1});
+    for (int algorithmChoice : optionList(options, "--algorithms", {1, 2, 3, 4, 5, 6})) {
+        bool timeSliced = algorithmChoice == 4 || algorithmChoice == 9;
+        for (int numCPUs : cpuCounts) {
+            for (int quantum : timeSliced ? optionList(options, "--quanta", {4}) : std::vector<int>{4}) {
+                quantum = std::max(1, quantum);   // never prompt from a worker
+                std::string name = createScheduler(algorithmChoice, numCPUs, quantum)->getAlgorithmName() +
+                                   ", " + std::to_string(numCPUs) + " CPU(s)";
+                if (timeSliced) {
+                    name += ", quantum " + std::to_string(quantum);
+                }
+                sweep->addConfiguration(name, [=]() { return createScheduler(algorithmChoice, numCPUs, quantum); });
+            }
+        }
+    }
+    
+    int largest = *std::max_element(cpuCounts.begin(), cpuCounts.end());
+    sweep->setWorkload(std::make_shared<const Workload>(workloadOption(options, largest)));
+    return sweep;
+}
+
+// One argument for a shell command line
+std::string shellQuote(const std::string& text) {
+#ifdef _WIN32
+    return "\"" + text + "\"";
+#else
+    std::string quoted = "'";
+    for (char c : text) {
+        quoted += c == '\'' ? std::string("'\\''") : std::string(1, c);
+    }
+    return quoted + "'";
+#endif
+}
+
+// Worker side of --sweep: runs one shard and writes its file
+int runSweepShard(int argc, char* argv[]) {
+    if (argc < 3) {
+        printUsage();
+        return 1;
+    }
+    int shard = std::stoi(argv[2]);
+    auto options = parseOptions(argc, argv, 3);
+    auto sweep = sweepOption(options);
+    sweep->runShard(shard);
+    std::cout << "Shard " << shard << " of " << sweep->getShardCount() << " done" << std::endl;
+    return 0;
+}
+
+// Launches a worker process for every shard without a current result, then
+// merges all shards. After a failure the same command runs only the shards
+// still missing.
+int runSweep(int argc, char* argv[]) {
+    auto options = parseOptions(argc, argv, 2);
+    auto sweep = sweepOption(options);
+    
+    std::string workerArguments = "--sweep-shard {shard}";
+    for (const auto& option : options) {
+        if (option.first != "--command" && option.first != "--workers") {
+            workerArguments += " " + option.first + " " + shellQuote(option.second);
+        }
+    }
+    std::string command = options.count("--command") ? options["--command"] : shellQuote(argv[0]) + " {args}";
+    size_t at = command.find("{args}");
+    if (at == std::string::npos) {
+        throw std::invalid_argument("--command needs an {args} placeholder");
+    }
+    command.replace(at, 6, workerArguments);
+    
+    size_t missing = sweep->missingShards().size();
+    std::cout << sweep->getConfigurationCount() << " configurations in " << sweep->getShardCount()
+              << " shards; " << missing << " to run" << std::endl;
+    int workers = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    std::vector<int> failed = sweep->launchMissing(command, optionInt(options, "--workers", workers));
+    
+    std::vector<int> stillMissing = sweep->missingShards();
+    if (!stillMissing.empty()) {
+        std::cerr << stillMissing.size() << " shard(s) failed:";
+        for (int shard : stillMissing) {
+            std::cerr << " " << shard;
+        }
+        std::cerr << ". Run the same command again to retry only these." << std::endl;
+        return 1;
+    }
+    if (!failed.empty()) {
+        std::cerr << "Warning: " << failed.size() << " worker(s) exited with an error after writing results" << std::endl;
+    }
+    Statistics::printSweepTable(sweep->merge());
+    return 0;
+}
+
+// Processes tagged with group paths (the last column of the process file),
+// scheduled by proportional shares per group and reported group by group
+int runGroupScheduling(int argc, char* argv[]) {
+    auto options = parseOptions(argc, argv, 2);
+    int numCPUs = optionInt(options, "--cpus", 1);
+    auto processes = workloadOption(options, numCPUs);
+    
+    const std::map<int, GroupInnerPolicy> innerPolicies = {
+        {1, INNER_FCFS}, {2, INNER_SJF}, {3, INNER_SJF}, {4, INNER_ROUND_ROBIN}, {5, INNER_PRIORITY}, {6, INNER_PRIORITY}};
+    auto inner = innerPolicies.find(optionInt(options, "--algorithm", 1));
+    if (inner == innerPolicies.end()) {
+        throw std::invalid_argument("Groups schedule with algorithms 1 to 6 inside each group");
+    }
+    GroupScheduler scheduler(numCPUs, inner->second, std::max(1, optionInt(options, "--quantum", 4)));
+    if (options.count("--shares")) {
+        std::istringstream list(options["--shares"]);
+        std::string item;
+        while (std::getline(list, item, ',')) {
+            size_t colon = item.rfind(':');
+            if (colon == std::string::npos) {
+                throw std::invalid_argument("Expected PATH:SHARES, got " + item);
+            }
+            scheduler.setShares(item.substr(0, colon), std::stoi(item.substr(colon + 1)));
+        }
+    }
+    if (options.count("--assign")) {
+        assignGroups(processes, options["--assign"]);
+    }
+    
+    scheduler.setQuiet(true);
+    scheduler.addProcesses(processes);
+    scheduler.run();
+    std::cout << scheduler.getAlgorithmName() << ": " << processes.size() << " processes on "
+              << numCPUs << " CPU(s)" << std::endl;
+    scheduler.printStatistics();
+    scheduler.printGroupStatistics();
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        try {
+            if (std::string(argv[1]) == "--stream") {
+                return runStreamingMode(argc, argv);
+            }
+            if (std::string(argv[1]) == "--compare-trace") {
+                return runTraceComparison(argc, argv);
+            }
+            if (std::string(argv[1]) == "--validate-solver") {
+                return runSolverValidation(argc, argv);
+            }
+            if (std::string(argv[1]) == "--tune-quantum") {
+                return runQuantumTuning(argc, argv);
+            }
+            if (std::string(argv[1]) == "--generate") {
+                return runWorkloadGeneration(argc, argv);
+            }
+            if (std::string(argv[1]) == "--replicate") {
+                return runReplications(argc, argv);
+            }
+            if (std::string(argv[1]) == "--check-allocations") {
+                return runAllocationCheck(argc, argv);
+            }
+            if (std::string(argv[1]) == "--check-cores") {
+                return runCoreCheck(argc, argv);
+            }
+            if (std::string(argv[1]) == "--read-trace") {
+                return runTraceReading(argc, argv);
+            }
+            if (std::string(argv[1]) == "--checkpoint" || std::string(argv[1]) == "--resume") {
+                return runCheckpointing(argc, argv);
+            }
+            if (std::string(argv[1]) == "--compare") {
+                return runComparison(argc, argv);
+            }
+            if (std::string(argv[1]) == "--what-if") {
+                return runWhatIf(argc, argv);
+            }
+            if (std::string(argv[1]) == "--partitioned") {
+                return runPartitioned(argc, argv);
+            }
+            if (std::string(argv[1]) == "--sweep") {
+                return runSweep(argc, argv);
+            }
+            if (std::string(argv[1]) == "--sweep-shard") {
+                return runSweepShard(argc, argv);
+            }
+            if (std::string(argv[1]) == "--groups") {
+                return runGroupScheduling(argc, argv);
+            }
+            printUsage();
+            return 1;
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    
     std::cout << "CPU Scheduling Simulator - Windows Version" << std::endl;
     std::cout << "Compiled with: " << __VERSION__ << std::endl;
     
@@ -270,7 +1466,8 @@ int main() {
                 case 3: testMultiCoreScheduling(); break;
                 case 4: generateRandomTestCase(); break;
                 case 5: loadFromFile(); break;
-                case 6: 
+                case 6: testHeterogeneousCPUs(); break;
+                case 7:
                     std::cout << "Thank you for using CPU Scheduling Simulator!" << std::endl;
                     return 0;
                 default:
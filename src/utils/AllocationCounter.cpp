@@ -0,0 +1,44 @@
+#include "AllocationCounter.h"
+
+#ifdef SCHED_COUNT_ALLOCATIONS
+#include <cstdlib>
+#include <new>
+
+static thread_local long long allocations = 0;
+
+// The array and nothrow forms forward to these by default
+void* operator new(std::size_t size) {
+    allocations++;
+    if (void* memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+bool AllocationCounter::enabled() {
+    return true;
+}
+
+long long AllocationCounter::count() {
+    return allocations;
+}
+
+#else
+
+bool AllocationCounter::enabled() {
+    return false;
+}
+
+long long AllocationCounter::count() {
+    return 0;
+}
+
+#endif
\ No newline at end of file
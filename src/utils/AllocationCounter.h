@@ -0,0 +1,13 @@
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+// Heap allocations made by the calling thread. The counting operator new is
+// only compiled in with -DSCHED_COUNT_ALLOCATIONS, so normal builds keep the
+// library allocator untouched; enabled() says which kind of build this is.
+class AllocationCounter {
+public:
+    static bool enabled();
+    static long long count();
+};
+
+#endif // ALLOCATIONCOUNTER_H
\ No newline at end of file
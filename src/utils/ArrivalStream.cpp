@@ -0,0 +1,142 @@
+#include "ArrivalStream.h"
+#include <sstream>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cstring>
+#include <cerrno>
+#endif
+
+std::shared_ptr<Process> ArrivalStream::parseLine(const std::string& line) {
+    if (line.empty() || line[0] == '#') return nullptr;
+    
+    std::istringstream iss(line);
+    int id, arrival, burst, priority;
+    std::string name;
+    
+    if (!(iss >> id >> arrival >> burst >> priority >> name)) return nullptr;
+    
+    auto process = std::make_shared<Process>(id, arrival, burst, priority, name);
+    int width;
+    std::string group;
+    if (iss >> width) {
+        process->setWidth(width);
+        if (iss >> group) {
+            process->setGroup(group);
+        }
+    }
+    return process;
+}
+
+std::shared_ptr<Process> TextArrivalStream::next() {
+    while (std::getline(input, line)) {
+        auto process = parseLine(line);
+        if (process) return process;
+    }
+    return nullptr;
+}
+
+#ifndef _WIN32
+
+UnixSocketArrivalStream::UnixSocketArrivalStream(const std::string& path)
+    : socketPath(path), listenFd(-1), clientFd(-1), bufferPos(0), endOfStream(false) {
+    sockaddr_un address{};
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw std::invalid_argument("Socket path too long: " + path);
+    }
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    
+    listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        throw std::runtime_error("Could not create socket: " + std::string(std::strerror(errno)));
+    }
+    
+    unlink(path.c_str());
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        listen(listenFd, 1) < 0) {
+        std::string reason = std::strerror(errno);
+        close(listenFd);
+        throw std::runtime_error("Could not listen on " + path + ": " + reason);
+    }
+}
+
+UnixSocketArrivalStream::~UnixSocketArrivalStream() {
+    if (clientFd >= 0) close(clientFd);
+    if (listenFd >= 0) {
+        close(listenFd);
+        unlink(socketPath.c_str());
+    }
+}
+
+bool UnixSocketArrivalStream::readLine(std::string& line) {
+    while (true) {
+        size_t newline = buffer.find('\n', bufferPos);
+        if (newline != std::string::npos) {
+            line.assign(buffer, bufferPos, newline - bufferPos);
+            bufferPos = newline + 1;
+            return true;
+        }
+        
+        if (endOfStream) {
+            if (bufferPos < buffer.size()) {
+                line.assign(buffer, bufferPos, std::string::npos);
+                bufferPos = buffer.size();
+                return true;
+            }
+            return false;
+        }
+        
+        // Compact consumed bytes before reading more
+        buffer.erase(0, bufferPos);
+        bufferPos = 0;
+        
+        char chunk[4096];
+        ssize_t received = read(clientFd, chunk, sizeof(chunk));
+        if (received < 0 && errno == EINTR) continue;
+        if (received <= 0) {
+            endOfStream = true;
+        } else {
+            buffer.append(chunk, static_cast<size_t>(received));
+        }
+    }
+}
+
+std::shared_ptr<Process> UnixSocketArrivalStream::next() {
+    if (clientFd < 0) {
+        clientFd = accept(listenFd, nullptr, nullptr);
+        if (clientFd < 0) {
+            throw std::runtime_error("Could not accept producer on " + socketPath + ": " +
+                                     std::strerror(errno));
+        }
+    }
+    
+    std::string line;
+    while (readLine(line)) {
+        auto process = parseLine(line);
+        if (process) return process;
+    }
+    return nullptr;
+}
+
+#else
+
+UnixSocketArrivalStream::UnixSocketArrivalStream(const std::string& path)
+    : socketPath(path), listenFd(-1), clientFd(-1), bufferPos(0), endOfStream(true) {
+    throw std::runtime_error("Unix socket input is not supported on this platform");
+}
+
+UnixSocketArrivalStream::~UnixSocketArrivalStream() {}
+
+bool UnixSocketArrivalStream::readLine(std::string&) {
+    return false;
+}
+
+std::shared_ptr<Process> UnixSocketArrivalStream::next() {
+    return nullptr;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,59 @@
+#ifndef ARRIVALSTREAM_H
+#define ARRIVALSTREAM_H
+
+#include "../Process.h"
+#include <memory>
+#include <string>
+#include <istream>
+
+// Source of process arrivals consumed incrementally by Scheduler::runStreaming.
+// Arrivals are expected in non-decreasing arrival time; a late arrival is
+// admitted at the current simulated time.
+class ArrivalStream {
+public:
+    virtual ~ArrivalStream() = default;
+    
+    // Next arrival, or nullptr once the stream is exhausted
+    virtual std::shared_ptr<Process> next() = 0;
+    
+    // Parses one line of the process file format:
+    // ProcessID ArrivalTime BurstTime Priority ProcessName [Width [Group]]
+    static std::shared_ptr<Process> parseLine(const std::string& line);
+};
+
+// Reads the process file format from any std::istream (e.g. std::cin)
+class TextArrivalStream : public ArrivalStream {
+private:
+    std::istream& input;
+    std::string line;
+    
+public:
+    explicit TextArrivalStream(std::istream& in) : input(in) {}
+    
+    std::shared_ptr<Process> next() override;
+};
+
+// Listens on a local Unix domain socket, accepts one producer connection and
+// reads the process file format from it until the producer disconnects
+class UnixSocketArrivalStream : public ArrivalStream {
+private:
+    std::string socketPath;
+    int listenFd;
+    int clientFd;
+    std::string buffer;
+    size_t bufferPos;
+    bool endOfStream;
+    
+    bool readLine(std::string& line);
+    
+public:
+    explicit UnixSocketArrivalStream(const std::string& path);
+    ~UnixSocketArrivalStream() override;
+    
+    UnixSocketArrivalStream(const UnixSocketArrivalStream&) = delete;
+    UnixSocketArrivalStream& operator=(const UnixSocketArrivalStream&) = delete;
+    
+    std::shared_ptr<Process> next() override;
+};
+
+#endif // ARRIVALSTREAM_H
\ No newline at end of file
@@ -0,0 +1,250 @@
+#include "AsyncWriter.h"
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+
+AsyncWriter::AsyncWriter(const std::string& filename, bool backgroundThread,
+                         size_t bufferBytes, size_t maxPending)
+    : file(filename, std::ios::binary), bufferSize(bufferBytes > 0 ? bufferBytes : 1),
+      maxPendingBuffers(maxPending > 0 ? maxPending : 1), background(backgroundThread),
+      opened(false), closing(false), failed(false), bytesWritten(0) {
+    if (!file.is_open()) {
+        failed = true;
+        return;
+    }
+    opened = true;
+    current.reserve(bufferSize);
+}
+
+AsyncWriter::~AsyncWriter() {
+    close();
+}
+
+void AsyncWriter::writeBuffer(const std::string& buffer) {
+    if (!file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()))) {
+        failed = true;
+    }
+}
+
+// Hands the current buffer to the writer thread and continues in a recycled one
+void AsyncWriter::submit() {
+    bytesWritten += static_cast<long long>(current.size());
+    if (!background) {
+        writeBuffer(current);
+        current.clear();
+        return;
+    }
+    if (!worker.joinable()) {
+        worker = std::thread(&AsyncWriter::writerLoop, this);
+    }
+    
+    std::unique_lock<std::mutex> lock(mutex);
+    bufferFree.wait(lock, [this] { return pending.size() < maxPendingBuffers; });
+    
+    pending.push_back(std::move(current));
+    if (!spare.empty()) {
+        current = std::move(spare.back());
+        spare.pop_back();
+    } else {
+        current = std::string();
+        current.reserve(bufferSize);
+    }
+    bufferReady.notify_one();
+}
+
+void AsyncWriter::writerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        bufferReady.wait(lock, [this] { return !pending.empty() || closing; });
+        if (pending.empty()) break;
+        
+        std::string buffer = std::move(pending.front());
+        pending.pop_front();
+        lock.unlock();
+        
+        // Only this thread touches the file until close() has joined it
+        bool ok = static_cast<bool>(file.write(buffer.data(), static_cast<std::streamsize>(buffer.size())));
+        buffer.clear();
+        
+        lock.lock();
+        failed = failed || !ok;
+        spare.push_back(std::move(buffer));
+        bufferFree.notify_one();
+    }
+}
+
+void AsyncWriter::write(const char* data, size_t length) {
+    if (!isOpen()) return;
+    
+    current.append(data, length);
+    if (current.size() >= bufferSize) {
+        submit();
+    }
+}
+
+AsyncWriter& AsyncWriter::operator<<(const std::string& text) {
+    write(text.data(), text.size());
+    return *this;
+}
+
+AsyncWriter& AsyncWriter::operator<<(const char* text) {
+    write(text, std::char_traits<char>::length(text));
+    return *this;
+}
+
+AsyncWriter& AsyncWriter::operator<<(char c) {
+    write(&c, 1);
+    return *this;
+}
+
+AsyncWriter& AsyncWriter::operator<<(int value) {
+    return *this << static_cast<long long>(value);
+}
+
+AsyncWriter& AsyncWriter::operator<<(long long value) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    write(digits, static_cast<size_t>(result.ptr - digits));
+    return *this;
+}
+
+AsyncWriter& AsyncWriter::operator<<(double value) {
+    char digits[64];
+    int length = std::snprintf(digits, sizeof(digits), "%.2f", value);
+    if (length > 0) {
+        write(digits, static_cast<size_t>(length));
+    }
+    return *this;
+}
+
+bool AsyncWriter::close() {
+    if (!opened) return !failed;
+    opened = false;
+    
+    if (worker.joinable()) {
+        if (!current.empty()) {
+            submit();
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closing = true;
+        }
+        bufferReady.notify_one();
+        worker.join();
+    } else if (!current.empty()) {
+        // Output that fit in one buffer never needed the thread
+        bytesWritten += static_cast<long long>(current.size());
+        writeBuffer(current);
+    }
+    current.clear();
+    
+    file.close();
+    failed = failed || file.fail();
+    return !failed;
+}
+
+RecordWriter::RecordWriter(AsyncWriter& writer, RecordFormat recordFormat,
+                           const std::vector<std::string>& fieldNames)
+    : out(writer), format(recordFormat), fields(fieldNames), column(0) {}
+
+void RecordWriter::writeHeader() {
+    if (format != FORMAT_CSV) return;
+    
+    for (size_t i = 0; i < fields.size(); ++i) {
+        if (i > 0) out << ',';
+        writeString(fields[i]);
+    }
+    out << '\n';
+}
+
+void RecordWriter::beginField() {
+    if (format == FORMAT_CSV) {
+        if (column > 0) out << ',';
+    } else {
+        out << (column == 0 ? '{' : ',');
+        writeString(column < fields.size() ? fields[column] : "field" + std::to_string(column));
+        out << ':';
+    }
+    column++;
+}
+
+// CSV quotes only when needed; JSON always quotes and escapes
+void RecordWriter::writeString(const std::string& value) {
+    if (format == FORMAT_CSV) {
+        if (value.find_first_of(",\"\n\r") == std::string::npos) {
+            out << value;
+            return;
+        }
+        out << '"';
+        for (char c : value) {
+            if (c == '"') out << '"';
+            out << c;
+        }
+        out << '"';
+        return;
+    }
+    
+    writeJSONString(out, value);
+}
+
+void RecordWriter::writeJSONString(AsyncWriter& out, const std::string& value) {
+    out << '"';
+    for (char c : value) {
+        switch (c) {
+            case '"':  out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\r': out << "\\r"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    out << escaped;
+                } else {
+                    out << c;
+                }
+        }
+    }
+    out << '"';
+}
+
+RecordWriter& RecordWriter::field(const std::string& value) {
+    beginField();
+    writeString(value);
+    return *this;
+}
+
+RecordWriter& RecordWriter::field(long long value) {
+    beginField();
+    out << value;
+    return *this;
+}
+
+// JSON has no NaN or infinity literals
+RecordWriter& RecordWriter::field(double value) {
+    beginField();
+    if (format == FORMAT_JSONL && !std::isfinite(value)) {
+        out << "null";
+    } else {
+        out << value;
+    }
+    return *this;
+}
+
+void RecordWriter::endRecord() {
+    if (format == FORMAT_JSONL) {
+        out << (column == 0 ? "{}" : "}");
+    }
+    out << '\n';
+    column = 0;
+}
+
+RecordFormat RecordWriter::formatForFile(const std::string& filename) {
+    const std::string extension = ".jsonl";
+    if (filename.size() >= extension.size() &&
+        filename.compare(filename.size() - extension.size(), extension.size(), extension) == 0) {
+        return FORMAT_JSONL;
+    }
+    return FORMAT_CSV;
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+#ifndef ASYNCWRITER_H
+#define ASYNCWRITER_H
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Output file fed through large in-memory buffers. In background mode full
+// buffers are handed to a writer thread over a bounded queue, so the caller only
+// formats text and blocks only when the disk falls maxPendingBuffers behind.
+//
+// The thread starts with the first full buffer. Once a process has a second
+// thread, libstdc++ makes every shared_ptr copy atomic for good, which costs
+// the simulator more than the writes it saves when the disk keeps up; callers
+// that write while simulating at full speed should use the inline mode.
+class AsyncWriter {
+private:
+    std::ofstream file;
+    size_t bufferSize;
+    size_t maxPendingBuffers;
+    bool background;
+    bool opened;
+    std::string current;
+    
+    std::mutex mutex;
+    std::condition_variable bufferReady;
+    std::condition_variable bufferFree;
+    std::deque<std::string> pending;
+    std::vector<std::string> spare;
+    bool closing;
+    bool failed;
+    long long bytesWritten;
+    std::thread worker;
+    
+    void submit();
+    void writeBuffer(const std::string& buffer);
+    void writerLoop();
+    
+public:
+    explicit AsyncWriter(const std::string& filename, bool backgroundThread = true,
+                         size_t bufferBytes = 1 << 20, size_t maxPending = 4);
+    ~AsyncWriter();
+    
+    AsyncWriter(const AsyncWriter&) = delete;
+    AsyncWriter& operator=(const AsyncWriter&) = delete;
+    
+    bool isOpen() const { return opened; }
+    
+    void write(const char* data, size_t length);
+    AsyncWriter& operator<<(const std::string& text);
+    AsyncWriter& operator<<(const char* text);
+    AsyncWriter& operator<<(char c);
+    AsyncWriter& operator<<(int value);
+    AsyncWriter& operator<<(long long value);
+    AsyncWriter& operator<<(double value);  // fixed, two decimals
+    
+    // Writes out everything buffered and stops the writer thread; returns false
+    // if the file could not be opened or any write failed
+    bool close();
+    long long getBytesWritten() const { return bytesWritten; }
+};
+
+enum RecordFormat {
+    FORMAT_CSV,     // header row, then one comma separated row per record
+    FORMAT_JSONL    // one JSON object per line
+};
+
+// Writes flat records with a fixed list of fields in CSV or JSON Lines
+class RecordWriter {
+private:
+    AsyncWriter& out;
+    RecordFormat format;
+    std::vector<std::string> fields;
+    size_t column;
+    
+    void beginField();
+    void writeString(const std::string& value);
+    
+public:
+    RecordWriter(AsyncWriter& writer, RecordFormat recordFormat,
+                 const std::vector<std::string>& fieldNames);
+    
+    // CSV header row; nothing for JSON Lines, whose records are self-describing
+    void writeHeader();
+    
+    RecordWriter& field(const std::string& value);
+    RecordWriter& field(long long value);
+    RecordWriter& field(int value) { return field(static_cast<long long>(value)); }
+    RecordWriter& field(double value);  // two decimals; null in JSON when not finite
+    void endRecord();
+    
+    // JSON Lines for ".jsonl" files, CSV otherwise
+    static RecordFormat formatForFile(const std::string& filename);
+    
+    // Quoted and escaped for JSON
+    static void writeJSONString(AsyncWriter& out, const std::string& value);
+};
+
+#endif // ASYNCWRITER_H
\ No newline at end of file
@@ -0,0 +1,381 @@
+#include "BinaryTrace.h"
+#include <stdexcept>
+
+static const char TRACE_MAGIC[8] = {'S', 'C', 'H', 'E', 'D', 'T', 'R', 'C'};
+static const char INDEX_MAGIC[8] = {'S', 'C', 'H', 'E', 'D', 'I', 'D', 'X'};
+static const int TRACE_VERSION = 1;
+static const long long TRAILER_SIZE = 16;
+
+static void putVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+// Zigzag keeps small negative numbers short
+static void putSigned(std::string& out, long long value) {
+    putVarint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+static uint64_t getVarint(const std::string& in, size_t& position) {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (position >= in.size()) {
+            throw std::runtime_error("Trace block ends inside a number");
+        }
+        unsigned char byte = static_cast<unsigned char>(in[position++]);
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return value;
+    }
+    throw std::runtime_error("Malformed number in trace");
+}
+
+static long long getSigned(const std::string& in, size_t& position) {
+    uint64_t value = getVarint(in, position);
+    return static_cast<long long>(value >> 1) ^ -static_cast<long long>(value & 1);
+}
+
+// Reads a varint straight from the file; false at a clean end of file
+static bool readVarint(std::istream& in, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        int byte = in.get();
+        if (byte == EOF) return false;
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+BinaryTraceWriter::BinaryTraceWriter(const std::string& filename, size_t bytesPerBlock)
+    : file(filename, false), blockBytes(bytesPerBlock), offset(0), started(false), nameCount(0) {}
+
+void BinaryTraceWriter::writeBlock(char type, const std::string& payload, const TraceBlock& entry) {
+    std::string header(1, type);
+    putVarint(header, payload.size());
+    file.write(header.data(), header.size());
+    file.write(payload.data(), payload.size());
+    
+    index.push_back(entry);
+    index.back().type = type;
+    index.back().offset = offset;
+    offset += static_cast<long long>(header.size() + payload.size());
+}
+
+void BinaryTraceWriter::onRunStart(const Scheduler& scheduler) {
+    if (started) {
+        throw std::logic_error("A binary trace holds a single run");
+    }
+    started = true;
+    
+    std::string header(TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    header.push_back(static_cast<char>(TRACE_VERSION));
+    putVarint(header, static_cast<uint64_t>(scheduler.getNumCPUs()));
+    file.write(header.data(), header.size());
+    offset += static_cast<long long>(header.size());
+    
+    streams.resize(scheduler.getNumCPUs());
+    for (auto& stream : streams) {
+        stream.bytes.reserve(blockBytes + 32);
+    }
+}
+
+void BinaryTraceWriter::onArrival(int, const Process& process) {
+    putSigned(names, process.getProcessID());
+    putVarint(names, process.getProcessName().size());
+    names += process.getProcessName();
+    nameCount++;
+    if (names.size() >= blockBytes) {
+        flushNames();
+    }
+}
+
+void BinaryTraceWriter::onDispatch(int time, int cpuID, const Process&) {
+    streams[cpuID].dispatchedAt = time;
+}
+
+void BinaryTraceWriter::onRelease(int time, int cpuID, const Process& process, bool completed) {
+    CPUStream& stream = streams[cpuID];
+    int start = stream.dispatchedAt;
+    if (time <= start) return;
+    
+    if (stream.count == 0) {
+        stream.firstStart = start;
+        stream.lastEnd = start;
+        stream.lastProcessID = 0;
+    }
+    putVarint(stream.bytes, static_cast<uint64_t>(start - stream.lastEnd));
+    putVarint(stream.bytes, (static_cast<uint64_t>(time - start) << 1) | (completed ? 1 : 0));
+    putSigned(stream.bytes, static_cast<long long>(process.getProcessID()) - stream.lastProcessID);
+    stream.lastEnd = time;
+    stream.lastProcessID = process.getProcessID();
+    stream.count++;
+    
+    if (stream.bytes.size() >= blockBytes) {
+        flushStream(cpuID);
+    }
+}
+
+void BinaryTraceWriter::flushStream(int cpu) {
+    CPUStream& stream = streams[cpu];
+    if (stream.count == 0) return;
+    
+    std::string payload;
+    putVarint(payload, static_cast<uint64_t>(cpu));
+    putVarint(payload, static_cast<uint64_t>(stream.count));
+    putVarint(payload, static_cast<uint64_t>(stream.firstStart));
+    payload += stream.bytes;
+    
+    TraceBlock entry;
+    entry.cpu = cpu;
+    entry.firstStart = stream.firstStart;
+    entry.lastEnd = stream.lastEnd;
+    entry.count = stream.count;
+    writeBlock('S', payload, entry);
+    
+    stream.bytes.clear();
+    stream.count = 0;
+}
+
+void BinaryTraceWriter::flushNames() {
+    if (nameCount == 0) return;
+    
+    std::string payload;
+    putVarint(payload, static_cast<uint64_t>(nameCount));
+    payload += names;
+    
+    TraceBlock entry;
+    entry.count = nameCount;
+    writeBlock('N', payload, entry);
+    
+    names.clear();
+    nameCount = 0;
+}
+
+bool BinaryTraceWriter::close() {
+    if (!started) {
+        std::string header(TRACE_MAGIC, sizeof(TRACE_MAGIC));
+        header.push_back(static_cast<char>(TRACE_VERSION));
+        putVarint(header, 0);
+        file.write(header.data(), header.size());
+        offset += static_cast<long long>(header.size());
+        started = true;
+    }
+    for (size_t cpu = 0; cpu < streams.size(); ++cpu) {
+        flushStream(static_cast<int>(cpu));
+    }
+    flushNames();
+    
+    std::string payload;
+    putVarint(payload, index.size());
+    for (const auto& entry : index) {
+        payload.push_back(entry.type);
+        putSigned(payload, entry.cpu);
+        putVarint(payload, static_cast<uint64_t>(entry.offset));
+        putVarint(payload, static_cast<uint64_t>(entry.firstStart));
+        putVarint(payload, static_cast<uint64_t>(entry.lastEnd));
+        putVarint(payload, static_cast<uint64_t>(entry.count));
+    }
+    long long indexOffset = offset;
+    std::string block(1, 'I');
+    putVarint(block, payload.size());
+    block += payload;
+    
+    // Fixed-size trailer: little-endian index offset, then the index magic
+    for (int i = 0; i < 8; ++i) {
+        block.push_back(static_cast<char>((static_cast<uint64_t>(indexOffset) >> (8 * i)) & 0xff));
+    }
+    block.append(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    file.write(block.data(), block.size());
+    offset += static_cast<long long>(block.size());
+    return file.close();
+}
+
+BinaryTraceReader::BinaryTraceReader(const std::string& filename)
+    : file(filename, std::ios::binary), cpuCount(0), indexed(false), nextBlock(0), decodedPosition(0) {
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open file " + filename);
+    }
+    
+    char magic[sizeof(TRACE_MAGIC)];
+    uint64_t cpus = 0;
+    if (!file.read(magic, sizeof(magic)) || std::string(magic, sizeof(magic)) != std::string(TRACE_MAGIC, sizeof(TRACE_MAGIC))) {
+        throw std::runtime_error("Not a scheduler trace: " + filename);
+    }
+    if (file.get() != TRACE_VERSION || !readVarint(file, cpus)) {
+        throw std::runtime_error("Unsupported trace version in " + filename);
+    }
+    cpuCount = static_cast<int>(cpus);
+    long long headerEnd = static_cast<long long>(file.tellg());
+    
+    // The trailer leads to the index; without one, the blocks are scanned
+    file.seekg(0, std::ios::end);
+    long long size = static_cast<long long>(file.tellg());
+    if (size >= headerEnd + TRAILER_SIZE) {
+        char trailer[TRAILER_SIZE];
+        file.seekg(size - TRAILER_SIZE);
+        file.read(trailer, TRAILER_SIZE);
+        if (std::string(trailer + 8, 8) == std::string(INDEX_MAGIC, sizeof(INDEX_MAGIC))) {
+            uint64_t indexOffset = 0;
+            for (int i = 0; i < 8; ++i) {
+                indexOffset |= static_cast<uint64_t>(static_cast<unsigned char>(trailer[i])) << (8 * i);
+            }
+            char type;
+            std::string payload = readPayload(static_cast<long long>(indexOffset), type);
+            size_t position = 0;
+            uint64_t count = getVarint(payload, position);
+            for (uint64_t i = 0; i < count; ++i) {
+                if (position >= payload.size()) {
+                    throw std::runtime_error("Truncated trace index in " + filename);
+                }
+                TraceBlock entry;
+                entry.type = payload[position++];
+                entry.cpu = static_cast<int>(getSigned(payload, position));
+                entry.offset = static_cast<long long>(getVarint(payload, position));
+                entry.firstStart = static_cast<int>(getVarint(payload, position));
+                entry.lastEnd = static_cast<int>(getVarint(payload, position));
+                entry.count = static_cast<long long>(getVarint(payload, position));
+                index.push_back(entry);
+            }
+            indexed = true;
+        }
+    }
+    if (!indexed) {
+        scanBlocks(headerEnd);
+    }
+    
+    for (const auto& block : index) {
+        if (block.type != 'N') continue;
+        char type;
+        std::string payload = readPayload(block.offset, type);
+        size_t position = 0;
+        uint64_t count = getVarint(payload, position);
+        for (uint64_t i = 0; i < count; ++i) {
+            int processID = static_cast<int>(getSigned(payload, position));
+            size_t length = static_cast<size_t>(getVarint(payload, position));
+            if (position + length > payload.size()) {
+                throw std::runtime_error("Truncated name block in " + filename);
+            }
+            names[processID] = payload.substr(position, length);
+            position += length;
+        }
+    }
+}
+
+std::string BinaryTraceReader::readPayload(long long offset, char& type) {
+    file.clear();
+    file.seekg(offset);
+    int byte = file.get();
+    uint64_t length = 0;
+    if (byte == EOF || !readVarint(file, length)) {
+        throw std::runtime_error("Trace block past the end of the file");
+    }
+    type = static_cast<char>(byte);
+    std::string payload(static_cast<size_t>(length), '\0');
+    if (!file.read(&payload[0], static_cast<std::streamsize>(length))) {
+        throw std::runtime_error("Trace block cut short");
+    }
+    return payload;
+}
+
+// Rebuilds the index of a file whose writer never closed it, up to the last
+// complete block
+void BinaryTraceReader::scanBlocks(long long from) {
+    file.clear();
+    file.seekg(from);
+    while (true) {
+        long long offset = static_cast<long long>(file.tellg());
+        int type = file.get();
+        uint64_t length = 0;
+        if (type == EOF || !readVarint(file, length)) break;
+        std::string payload(static_cast<size_t>(length), '\0');
+        if (!file.read(&payload[0], static_cast<std::streamsize>(length))) break;
+        if (type != 'S' && type != 'N') break;
+        
+        TraceBlock entry;
+        entry.type = static_cast<char>(type);
+        entry.offset = offset;
+        size_t position = 0;
+        if (type == 'S') {
+            entry.cpu = static_cast<int>(getVarint(payload, position));
+            entry.count = static_cast<long long>(getVarint(payload, position));
+            entry.firstStart = static_cast<int>(getVarint(payload, position));
+            long long time = entry.firstStart;
+            for (long long i = 0; i < entry.count; ++i) {
+                time += static_cast<long long>(getVarint(payload, position));
+                time += static_cast<long long>(getVarint(payload, position) >> 1);
+                getSigned(payload, position);
+            }
+            entry.lastEnd = static_cast<int>(time);
+        } else {
+            entry.count = static_cast<long long>(getVarint(payload, position));
+        }
+        index.push_back(entry);
+    }
+    file.clear();
+}
+
+void BinaryTraceReader::decodeSegments(const TraceBlock& block, std::vector<TraceSegment>& out) {
+    char type;
+    std::string payload = readPayload(block.offset, type);
+    size_t position = 0;
+    TraceSegment segment;
+    segment.cpu = static_cast<int>(getVarint(payload, position));
+    long long count = static_cast<long long>(getVarint(payload, position));
+    long long time = static_cast<long long>(getVarint(payload, position));
+    long long processID = 0;
+    
+    out.clear();
+    out.reserve(static_cast<size_t>(count));
+    for (long long i = 0; i < count; ++i) {
+        segment.start = static_cast<int>(time + static_cast<long long>(getVarint(payload, position)));
+        uint64_t lengthAndFlag = getVarint(payload, position);
+        segment.end = segment.start + static_cast<int>(lengthAndFlag >> 1);
+        segment.completed = (lengthAndFlag & 1) != 0;
+        processID += getSigned(payload, position);
+        segment.processID = static_cast<int>(processID);
+        time = segment.end;
+        out.push_back(segment);
+    }
+}
+
+std::string BinaryTraceReader::getProcessName(int processID) const {
+    auto it = names.find(processID);
+    return it != names.end() ? it->second : "P" + std::to_string(processID);
+}
+
+bool BinaryTraceReader::next(TraceSegment& segment) {
+    while (decodedPosition >= decoded.size()) {
+        if (nextBlock >= index.size()) return false;
+        const TraceBlock& block = index[nextBlock++];
+        if (block.type == 'S') {
+            decodeSegments(block, decoded);
+            decodedPosition = 0;
+        }
+    }
+    segment = decoded[decodedPosition++];
+    return true;
+}
+
+void BinaryTraceReader::rewind() {
+    nextBlock = 0;
+    decoded.clear();
+    decodedPosition = 0;
+}
+
+void BinaryTraceReader::forEachSegment(int cpu, int from, int to,
+                                       const std::function<void(const TraceSegment&)>& visit) {
+    std::vector<TraceSegment> segments;
+    for (const auto& block : index) {
+        if (block.type != 'S' || block.cpu != cpu) continue;
+        if (block.lastEnd <= from || block.firstStart >= to) continue;
+        decodeSegments(block, segments);
+        for (const auto& segment : segments) {
+            if (segment.end > from && segment.start < to) {
+                visit(segment);
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+#ifndef BINARYTRACE_H
+#define BINARYTRACE_H
+
+#include "../Scheduler.h"
+#include "AsyncWriter.h"
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+// Compact archive of one run's schedule: every stretch a process ran on a CPU.
+//
+// After an 8-byte magic and a header (version, CPU count), the file is a
+// sequence of blocks: a type byte, the payload length as a varint, the
+// payload. Segment blocks belong to one CPU and are decodable on their own;
+// each segment is stored as the gap since the previous segment on that CPU,
+// its length (with the completed flag in the low bit) and the zigzag change
+// in process ID from the previous segment, all LEB128 varints. Name blocks
+// map process IDs to names. An index block listing every block's offset and
+// time span, followed by a fixed trailer pointing at it, ends the file; a file
+// cut short before its index is still read by scanning its blocks.
+struct TraceSegment {
+    int cpu = 0;
+    int start = 0;
+    int end = 0;
+    int processID = 0;
+    bool completed = false;     // false: preempted or descheduled
+};
+
+struct TraceBlock {
+    char type = 'S';            // 'S' segments, 'N' process names
+    int cpu = -1;
+    long long offset = 0;       // of the type byte
+    int firstStart = 0;
+    int lastEnd = 0;
+    long long count = 0;
+};
+
+// Observes a run and writes it as it simulates; per CPU it keeps one block's
+// worth of encoded segments before writing them out
+class BinaryTraceWriter : public ScheduleObserver {
+private:
+    AsyncWriter file;
+    size_t blockBytes;
+    long long offset;
+    bool started;
+    
+    struct CPUStream {
+        std::string bytes;
+        int dispatchedAt = 0;
+        int firstStart = 0;
+        int lastEnd = 0;
+        int lastProcessID = 0;
+        long long count = 0;
+    };
+    std::vector<CPUStream> streams;
+    std::string names;
+    long long nameCount;
+    std::vector<TraceBlock> index;
+    
+    void writeBlock(char type, const std::string& payload, const TraceBlock& entry);
+    void flushStream(int cpu);
+    void flushNames();
+    
+public:
+    explicit BinaryTraceWriter(const std::string& filename, size_t blockBytes = 64 * 1024);
+    
+    bool isOpen() const { return file.isOpen(); }
+    
+    void onRunStart(const Scheduler& scheduler) override;
+    void onArrival(int time, const Process& process) override;
+    void onDispatch(int time, int cpuID, const Process& process) override;
+    void onRelease(int time, int cpuID, const Process& process, bool completed) override;
+    
+    // Writes the remaining blocks, the index and the trailer; returns false if
+    // any write failed
+    bool close();
+    
+    long long getBytesWritten() const { return offset; }
+};
+
+// Reads a trace block by block, so only one block is decoded at a time
+class BinaryTraceReader {
+private:
+    std::ifstream file;
+    int cpuCount;
+    std::vector<TraceBlock> index;
+    std::map<int, std::string> names;
+    bool indexed;
+    
+    // Sequential reading state
+    size_t nextBlock;
+    std::vector<TraceSegment> decoded;
+    size_t decodedPosition;
+    
+    std::string readPayload(long long offset, char& type);
+    void decodeSegments(const TraceBlock& block, std::vector<TraceSegment>& out);
+    void scanBlocks(long long from);
+    
+public:
+    explicit BinaryTraceReader(const std::string& filename);
+    
+    int getCPUCount() const { return cpuCount; }
+    bool hasIndex() const { return indexed; }     // false for a file cut short
+    const std::vector<TraceBlock>& getBlocks() const { return index; }
+    std::string getProcessName(int processID) const;
+    
+    // Every segment, CPU block by CPU block in file order; false at the end
+    bool next(TraceSegment& segment);
+    void rewind();
+    
+    // Segments on one CPU that overlap [from, to), decoding only the blocks
+    // whose time span can hold them
+    void forEachSegment(int cpu, int from, int to, const std::function<void(const TraceSegment&)>& visit);
+};
+
+#endif // BINARYTRACE_H
\ No newline at end of file
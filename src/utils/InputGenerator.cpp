@@ -1,4 +1,6 @@
 #include "InputGenerator.h"
+#include "ArrivalStream.h"
+#include "AsyncWriter.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -7,10 +9,11 @@
 #include <iomanip>
 
 std::vector<std::shared_ptr<Process>> InputGenerator::generateRandomProcesses(
-    int count, int maxArrival, int maxBurst, int maxPriority) {
+    int count, int maxArrival, int maxBurst, int maxPriority, unsigned long long seed) {
     
     std::vector<std::shared_ptr<Process>> processes;
-    std::mt19937 rng(std::chrono::steady_clock::now().time_since_epoch().count());
+    processes.reserve(count);
+    std::mt19937 rng(seed != 0 ? seed : std::chrono::steady_clock::now().time_since_epoch().count());
     std::uniform_int_distribution<int> arrivalDist(0, maxArrival);
     std::uniform_int_distribution<int> burstDist(1, maxBurst);
     std::uniform_int_distribution<int> priorityDist(0, maxPriority);
@@ -92,24 +95,52 @@ std::vector<std::shared_ptr<Process>> InputGenerator::getConvoyEffectCase() {
     return processes;
 }
 
+std::vector<std::shared_ptr<Process>> InputGenerator::getParallelJobTestCase() {
+    std::vector<std::shared_ptr<Process>> processes;
+    
+    // (id, arrival, burst, priority, name) followed by the number of CPUs each job needs
+    processes.push_back(std::make_shared<Process>(1, 0, 6, 0, "Wide1"));
+    processes.back()->setWidth(3);
+    processes.push_back(std::make_shared<Process>(2, 1, 8, 0, "Wide2"));
+    processes.back()->setWidth(4);
+    processes.push_back(std::make_shared<Process>(3, 2, 3, 0, "Small3"));
+    processes.back()->setWidth(1);
+    processes.push_back(std::make_shared<Process>(4, 2, 10, 0, "Mid4"));
+    processes.back()->setWidth(2);
+    processes.push_back(std::make_shared<Process>(5, 3, 2, 0, "Small5"));
+    processes.back()->setWidth(1);
+    processes.push_back(std::make_shared<Process>(6, 4, 4, 0, "Mid6"));
+    processes.back()->setWidth(2);
+    
+    return processes;
+}
+
 void InputGenerator::saveToFile(const std::vector<std::shared_ptr<Process>>& processes,
                                const std::string& filename) {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
+    AsyncWriter file(filename);
+    if (!file.isOpen()) {
         std::cerr << "Error: Could not open file " << filename << std::endl;
         return;
     }
     
-    file << "# ProcessID ArrivalTime BurstTime Priority ProcessName" << std::endl;
+    file << "# ProcessID ArrivalTime BurstTime Priority ProcessName [Width [Group]]\n";
     for (const auto& process : processes) {
         file << process->getProcessID() << " "
              << process->getArrivalTime() << " "
              << process->getBurstTime() << " "
              << process->getPriority() << " "
-             << process->getProcessName() << std::endl;
+             << process->getProcessName() << " "
+             << process->getWidth();
+        if (!process->getGroup().empty()) {
+            file << " " << process->getGroup();
+        }
+        file << '\n';
     }
     
-    file.close();
+    if (!file.close()) {
+        std::cerr << "Error: Could not write file " << filename << std::endl;
+        return;
+    }
     std::cout << "Saved " << processes.size() << " processes to " << filename << std::endl;
 }
 
@@ -124,14 +155,9 @@ std::vector<std::shared_ptr<Process>> InputGenerator::loadFromFile(const std::st
     
     std::string line;
     while (std::getline(file, line)) {
-        if (line.empty() || line[0] == '#') continue;
-        
-        std::istringstream iss(line);
-        int id, arrival, burst, priority;
-        std::string name;
-        
-        if (iss >> id >> arrival >> burst >> priority >> name) {
-            processes.push_back(std::make_shared<Process>(id, arrival, burst, priority, name));
+        auto process = ArrivalStream::parseLine(line);
+        if (process) {
+            processes.push_back(process);
         }
     }
     
@@ -8,14 +8,16 @@
 
 class InputGenerator {
 public:
+    // Uniform arrivals, bursts and priorities; seed 0 seeds from the clock
     static std::vector<std::shared_ptr<Process>> generateRandomProcesses(
-        int count, int maxArrival, int maxBurst, int maxPriority = 5);
+        int count, int maxArrival, int maxBurst, int maxPriority = 5, unsigned long long seed = 0);
     
     static std::vector<std::shared_ptr<Process>> getClassicTestCase();
     static std::vector<std::shared_ptr<Process>> getRoundRobinTestCase();
     static std::vector<std::shared_ptr<Process>> getPriorityTestCase();
     static std::vector<std::shared_ptr<Process>> getMultiCoreTestCase();
     static std::vector<std::shared_ptr<Process>> getConvoyEffectCase();
+    static std::vector<std::shared_ptr<Process>> getParallelJobTestCase();
     
     static void saveToFile(const std::vector<std::shared_ptr<Process>>& processes,
                           const std::string& filename);
@@ -0,0 +1,405 @@
+#include "LinuxTraceImporter.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// Small parsing helpers over [begin, end) ranges; the hot path never builds
+// std::string or touches locale-aware streams
+
+static const char* skipSpaces(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t')) ++p;
+    return p;
+}
+
+static const char* findText(const char* begin, const char* end, const char* text) {
+    size_t length = std::strlen(text);
+    if (static_cast<size_t>(end - begin) < length) return nullptr;
+    const char* last = end - length;
+    for (const char* p = begin; p <= last; ++p) {
+        if (*p == text[0] && std::memcmp(p, text, length) == 0) return p;
+    }
+    return nullptr;
+}
+
+static bool parseInt(const char* begin, const char* end, long long& value) {
+    const char* p = begin;
+    bool negative = false;
+    if (p < end && *p == '-') {
+        negative = true;
+        ++p;
+    }
+    if (p >= end || *p < '0' || *p > '9') return false;
+    value = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        value = value * 10 + (*p - '0');
+        ++p;
+    }
+    if (negative) value = -value;
+    return true;
+}
+
+// Value of `key=` up to the next space, e.g. field(payload, end, "prev_pid=")
+static bool findField(const char* begin, const char* end, const char* key,
+                      const char*& valueBegin, const char*& valueEnd) {
+    const char* p = begin;
+    while ((p = findText(p, end, key)) != nullptr) {
+        // Require a field boundary so "pid=" does not match inside "prev_pid="
+        if (p == begin || p[-1] == ' ') {
+            valueBegin = p + std::strlen(key);
+            valueEnd = valueBegin;
+            while (valueEnd < end && *valueEnd != ' ') ++valueEnd;
+            return true;
+        }
+        ++p;
+    }
+    return false;
+}
+
+static bool fieldInt(const char* begin, const char* end, const char* key, long long& value) {
+    const char* vb;
+    const char* ve;
+    return findField(begin, end, key, vb, ve) && parseInt(vb, ve, value);
+}
+
+// "12345.678901" -> nanoseconds, exact for up to 9 fractional digits
+static bool parseTimestamp(const char* begin, const char* end, long long& ns) {
+    long long seconds = 0;
+    const char* p = begin;
+    if (p >= end || *p < '0' || *p > '9') return false;
+    while (p < end && *p >= '0' && *p <= '9') {
+        seconds = seconds * 10 + (*p - '0');
+        ++p;
+    }
+    if (p >= end || *p != '.') return false;
+    ++p;
+    long long fraction = 0;
+    int digits = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        if (digits < 9) {
+            fraction = fraction * 10 + (*p - '0');
+            ++digits;
+        }
+        ++p;
+    }
+    while (digits < 9) {
+        fraction *= 10;
+        ++digits;
+    }
+    ns = seconds * 1000000000LL + fraction;
+    return true;
+}
+
+// Pretty-printed task "comm:pid [prio]" as used by newer perf versions
+static bool parseTaskToken(const char* begin, const char* end, std::string& comm,
+                           long long& pid, long long& prio) {
+    const char* bracket = findText(begin, end, " [");
+    if (!bracket) return false;
+    const char* colon = bracket;
+    while (colon > begin && *colon != ':') --colon;
+    if (*colon != ':' || !parseInt(colon + 1, bracket, pid)) return false;
+    comm.assign(skipSpaces(begin, colon), colon);
+    return parseInt(bracket + 2, end, prio);
+}
+
+double ObservedSummary::cpuUtilization() const {
+    long long capacity = spanTicks * cpuCount;
+    return capacity > 0 ? (double)busyTicks / capacity * 100.0 : 0.0;
+}
+
+LinuxTraceImporter::LinuxTraceImporter(std::istream& in, const TraceImportOptions& opts)
+    : options(opts), input(in), buffer(std::max<size_t>(opts.bufferSize, 4096)),
+      bufferStart(0), bufferEnd(0), inputDone(false), firstTimestamp(-1),
+      lastTimestamp(0), nextProcessID(1), linesRead(0), eventsParsed(0) {}
+
+long long LinuxTraceImporter::toTicks(long long ns) const {
+    if (firstTimestamp < 0) return 0;
+    return static_cast<long long>(std::floor((ns - firstTimestamp) * options.ticksPerSecond / 1e9));
+}
+
+bool LinuxTraceImporter::nextLine(const char*& begin, const char*& end) {
+    while (true) {
+        const char* start = buffer.data() + bufferStart;
+        const char* stop = buffer.data() + bufferEnd;
+        const char* newline = static_cast<const char*>(std::memchr(start, '\n', stop - start));
+        if (newline) {
+            begin = start;
+            end = newline;
+            bufferStart = newline - buffer.data() + 1;
+            return true;
+        }
+        
+        if (inputDone) {
+            if (bufferStart < bufferEnd) {
+                begin = start;
+                end = stop;
+                bufferStart = bufferEnd;
+                return true;
+            }
+            return false;
+        }
+        
+        // Keep the partial line, grow only if a single line exceeds the buffer
+        size_t pending = bufferEnd - bufferStart;
+        std::memmove(buffer.data(), buffer.data() + bufferStart, pending);
+        bufferStart = 0;
+        bufferEnd = pending;
+        if (bufferEnd == buffer.size()) {
+            buffer.resize(buffer.size() * 2);
+        }
+        
+        input.read(buffer.data() + bufferEnd, buffer.size() - bufferEnd);
+        std::streamsize received = input.gcount();
+        bufferEnd += static_cast<size_t>(received);
+        if (received == 0 || !input) {
+            inputDone = true;
+        }
+    }
+}
+
+bool LinuxTraceImporter::pump(TraceSink& sink) {
+    const char* begin;
+    const char* end;
+    if (!nextLine(begin, end)) return false;
+    
+    linesRead++;
+    handleLine(begin, end, sink);
+    return true;
+}
+
+void LinuxTraceImporter::importAll(TraceSink& sink) {
+    while (pump(sink)) {}
+    finish(sink);
+}
+
+void LinuxTraceImporter::handleLine(const char* begin, const char* end, TraceSink& sink) {
+    const char* event = findText(begin, end, "sched_switch:");
+    bool isSwitch = event != nullptr;
+    if (!event) {
+        event = findText(begin, end, "sched_wakeup");
+        if (!event) return;
+    }
+    
+    // "[003]" CPU field followed by the "12345.678901:" timestamp
+    int cpu = -1;
+    long long ns = 0;
+    bool haveTimestamp = false;
+    for (const char* p = begin; p < event; ++p) {
+        if (cpu < 0 && *p == '[') {
+            long long value;
+            const char* close = static_cast<const char*>(std::memchr(p, ']', event - p));
+            if (close && parseInt(p + 1, close, value)) {
+                cpu = static_cast<int>(value);
+                p = close;
+            }
+        } else if (cpu >= 0 && *p >= '0' && *p <= '9' && p[-1] == ' ') {
+            const char* tokenEnd = p;
+            while (tokenEnd < event && *tokenEnd != ':' && *tokenEnd != ' ') ++tokenEnd;
+            if (tokenEnd < event && *tokenEnd == ':' && parseTimestamp(p, tokenEnd, ns)) {
+                haveTimestamp = true;
+                break;
+            }
+        }
+    }
+    if (cpu < 0 || !haveTimestamp) return;
+    
+    if (firstTimestamp < 0) firstTimestamp = ns;
+    lastTimestamp = std::max(lastTimestamp, ns);
+    if (cpu >= static_cast<int>(cpuCurrentPid.size())) {
+        cpuCurrentPid.resize(cpu + 1, 0);
+        summary.cpuCount = static_cast<int>(cpuCurrentPid.size());
+    }
+    eventsParsed++;
+    
+    const char* payload = static_cast<const char*>(std::memchr(event, ':', end - event));
+    if (!payload) return;
+    payload = skipSpaces(payload + 1, end);
+    
+    if (isSwitch) {
+        handleSwitch(cpu, ns, payload, end, sink);
+    } else {
+        handleWakeup(ns, payload, end);
+    }
+}
+
+void LinuxTraceImporter::handleSwitch(int cpu, long long ns, const char* payload, const char* end,
+                                      TraceSink& sink) {
+    std::string prevComm, nextComm;
+    long long prevPid, nextPid, prevPrio = 120, nextPrio = 120;
+    char prevState = 'R';
+    
+    const char* vb;
+    const char* ve;
+    if (findField(payload, end, "prev_pid=", vb, ve)) {
+        // ftrace / older perf: key=value pairs
+        if (!parseInt(vb, ve, prevPid) || !fieldInt(payload, end, "next_pid=", nextPid)) return;
+        fieldInt(payload, end, "prev_prio=", prevPrio);
+        fieldInt(payload, end, "next_prio=", nextPrio);
+        if (findField(payload, end, "prev_state=", vb, ve) && vb < ve) prevState = *vb;
+        if (findField(payload, end, "next_comm=", vb, ve)) nextComm.assign(vb, ve);
+    } else {
+        // perf pretty print: "prev:pid [prio] S ==> next:pid [prio]"
+        const char* arrow = findText(payload, end, " ==> ");
+        if (!arrow) return;
+        if (!parseTaskToken(payload, arrow, prevComm, prevPid, prevPrio)) return;
+        if (!parseTaskToken(arrow + 5, end, nextComm, nextPid, nextPrio)) return;
+        const char* stateEnd = arrow;
+        const char* stateBegin = stateEnd;
+        while (stateBegin > payload && stateBegin[-1] != ' ') --stateBegin;
+        if (stateBegin < stateEnd) prevState = *stateBegin;
+    }
+    
+    if (prevPid != 0) {
+        auto& task = tasks[static_cast<int>(prevPid)];
+        task.priority = static_cast<int>(prevPrio);
+        if (task.runningCPU == cpu) {
+            long long start = toTicks(task.switchedIn);
+            long long stop = toTicks(ns);
+            sink.onSegment({cpu, static_cast<int>(prevPid), start, stop});
+            summary.busyTicks += stop - start;
+            task.service += ns - task.switchedIn;
+            task.runningCPU = -1;
+        }
+        // Still runnable ('R', "R+") means preempted; anything else ends the burst
+        if (task.open && prevState != 'R') {
+            closeBurst(static_cast<int>(prevPid), task, ns, sink);
+        }
+    }
+    
+    cpuCurrentPid[cpu] = static_cast<int>(nextPid);
+    if (nextPid != 0) {
+        auto& task = tasks[static_cast<int>(nextPid)];
+        if (!nextComm.empty()) task.comm = nextComm;
+        task.priority = static_cast<int>(nextPrio);
+        if (!task.open) openBurst(static_cast<int>(nextPid), task, ns);
+        if (task.firstRun < 0) task.firstRun = ns;
+        task.runningCPU = cpu;
+        task.switchedIn = ns;
+    }
+}
+
+void LinuxTraceImporter::handleWakeup(long long ns, const char* payload, const char* end) {
+    std::string comm;
+    long long pid, prio = 120;
+    const char* vb;
+    const char* ve;
+    
+    if (findField(payload, end, "pid=", vb, ve)) {
+        if (!parseInt(vb, ve, pid)) return;
+        fieldInt(payload, end, "prio=", prio);
+        if (findField(payload, end, "comm=", vb, ve)) comm.assign(vb, ve);
+    } else if (!parseTaskToken(payload, end, comm, pid, prio)) {
+        return;
+    }
+    if (pid == 0) return;
+    
+    auto& task = tasks[static_cast<int>(pid)];
+    if (!comm.empty()) task.comm = comm;
+    task.priority = static_cast<int>(prio);
+    if (!task.open) openBurst(static_cast<int>(pid), task, ns);
+}
+
+void LinuxTraceImporter::openBurst(int, TaskState& task, long long ns) {
+    task.open = true;
+    task.arrival = ns;
+    task.firstRun = -1;
+    task.service = 0;
+    openArrivals.insert(toTicks(ns));
+}
+
+void LinuxTraceImporter::closeBurst(int pid, TaskState& task, long long ns, TraceSink& sink) {
+    task.open = false;
+    openArrivals.erase(openArrivals.find(toTicks(task.arrival)));
+    
+    long long arrival = toTicks(task.arrival);
+    long long completion = toTicks(ns);
+    long long firstRun = task.firstRun < 0 ? completion : toTicks(task.firstRun);
+    // Any burst that ran at all lasts at least one tick in the simulator
+    long long burst = static_cast<long long>(std::ceil(task.service * options.ticksPerSecond / 1e9));
+    if (burst <= 0) return;
+    completion = std::max(completion, arrival + burst);
+    
+    std::string name = (task.comm.empty() ? std::string("task") : task.comm) + "-" + std::to_string(pid);
+    auto process = std::make_shared<Process>(nextProcessID++, static_cast<int>(arrival),
+                                             static_cast<int>(burst), task.priority, name);
+    
+    summary.bursts++;
+    summary.totalTurnaroundTime += completion - arrival;
+    summary.totalWaitingTime += completion - arrival - burst;
+    summary.totalResponseTime += firstRun - arrival;
+    summary.spanTicks = std::max(summary.spanTicks, completion);
+    
+    sink.onBurst({process, firstRun, completion});
+}
+
+void LinuxTraceImporter::finish(TraceSink& sink) {
+    // Tasks still on a CPU or with a burst open when the trace ends: account
+    // what was observed. They are closed by burst start and then PID, not in
+    // hash order, so process IDs (and tie-breaks) are the same everywhere.
+    std::vector<std::pair<long long, int>> pending;
+    for (const auto& entry : tasks) {
+        if (entry.second.runningCPU >= 0 || entry.second.open) {
+            pending.push_back({entry.second.open ? entry.second.arrival : entry.second.switchedIn, entry.first});
+        }
+    }
+    std::sort(pending.begin(), pending.end());
+    
+    for (const auto& item : pending) {
+        int pid = item.second;
+        auto& task = tasks[pid];
+        if (task.runningCPU >= 0) {
+            long long start = toTicks(task.switchedIn);
+            long long stop = toTicks(lastTimestamp);
+            sink.onSegment({task.runningCPU, pid, start, stop});
+            summary.busyTicks += stop - start;
+            task.service += lastTimestamp - task.switchedIn;
+            task.runningCPU = -1;
+        }
+        if (task.open) {
+            closeBurst(pid, task, lastTimestamp, sink);
+        }
+    }
+    summary.spanTicks = std::max(summary.spanTicks, toTicks(lastTimestamp));
+}
+
+long long LinuxTraceImporter::getArrivalWatermark() const {
+    long long now = toTicks(lastTimestamp);
+    if (openArrivals.empty()) return now;
+    return std::min(now, *openArrivals.begin());
+}
+
+LinuxTraceArrivalStream::LinuxTraceArrivalStream(std::istream& in, const TraceImportOptions& opts,
+                                                 TraceSink* traceObserver)
+    : importer(in, opts), observer(traceObserver), maxReorderDelay(opts.maxReorderDelay),
+      finished(false) {}
+
+void LinuxTraceArrivalStream::onBurst(const ObservedBurst& burst) {
+    reorderBuffer.push(burst.process);
+    if (observer) observer->onBurst(burst);
+}
+
+void LinuxTraceArrivalStream::onSegment(const ObservedSegment& segment) {
+    if (observer) observer->onSegment(segment);
+}
+
+std::shared_ptr<Process> LinuxTraceArrivalStream::next() {
+    while (!finished) {
+        if (!reorderBuffer.empty()) {
+            long long earliest = reorderBuffer.top()->getArrivalTime();
+            long long watermark = importer.getArrivalWatermark();
+            // Safe once no open burst can still arrive earlier, or once we
+            // have waited long enough that holding it back costs too much
+            if (earliest <= watermark || importer.getCurrentTick() - earliest > maxReorderDelay) {
+                break;
+            }
+        }
+        if (!importer.pump(*this)) {
+            importer.finish(*this);
+            finished = true;
+        }
+    }
+    
+    if (reorderBuffer.empty()) return nullptr;
+    auto process = reorderBuffer.top();
+    reorderBuffer.pop();
+    return process;
+}
\ No newline at end of file
@@ -0,0 +1,150 @@
+#ifndef LINUXTRACEIMPORTER_H
+#define LINUXTRACEIMPORTER_H
+
+#include "ArrivalStream.h"
+#include <istream>
+#include <memory>
+#include <queue>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct TraceImportOptions {
+    double ticksPerSecond = 1000.0;     // simulated time units per traced second
+    size_t bufferSize = 1 << 20;        // bytes read from the trace per chunk
+    long long maxReorderDelay = 10000;  // ticks an arrival may be held back for ordering
+};
+
+// One interval a task actually spent on a CPU in the trace, in ticks
+struct ObservedSegment {
+    int cpu;
+    int pid;
+    long long start;
+    long long end;
+};
+
+// One CPU burst (wakeup until the task blocks or exits) turned into a process,
+// together with what the kernel actually did with it
+struct ObservedBurst {
+    std::shared_ptr<Process> process;
+    long long firstRun;
+    long long completion;
+};
+
+class TraceSink {
+public:
+    virtual ~TraceSink() = default;
+    virtual void onBurst(const ObservedBurst& burst) = 0;
+    virtual void onSegment(const ObservedSegment&) {}
+};
+
+// What the kernel achieved on the traced workload, in the simulator's metrics
+struct ObservedSummary {
+    long long bursts = 0;
+    double totalWaitingTime = 0.0;
+    double totalTurnaroundTime = 0.0;
+    double totalResponseTime = 0.0;
+    long long busyTicks = 0;
+    long long spanTicks = 0;
+    int cpuCount = 0;
+    
+    double averageWaitingTime() const { return bursts ? totalWaitingTime / bursts : 0.0; }
+    double averageTurnaroundTime() const { return bursts ? totalTurnaroundTime / bursts : 0.0; }
+    double averageResponseTime() const { return bursts ? totalResponseTime / bursts : 0.0; }
+    double cpuUtilization() const;
+};
+
+// Streams `perf sched script` or ftrace text (sched_switch / sched_wakeup) and
+// turns it into process arrivals and the observed per-CPU schedule. Only the
+// state of tasks and CPUs is kept, never the trace itself.
+class LinuxTraceImporter {
+private:
+    struct TaskState {
+        std::string comm;
+        int priority = 120;
+        bool open = false;             // a burst is in progress
+        long long arrival = 0;         // ns
+        long long firstRun = -1;       // ns
+        long long service = 0;         // ns
+        int runningCPU = -1;
+        long long switchedIn = 0;      // ns
+    };
+    
+    TraceImportOptions options;
+    std::istream& input;
+    std::vector<char> buffer;
+    size_t bufferStart;
+    size_t bufferEnd;
+    bool inputDone;
+    
+    std::unordered_map<int, TaskState> tasks;
+    std::vector<int> cpuCurrentPid;
+    std::multiset<long long> openArrivals;
+    long long firstTimestamp;
+    long long lastTimestamp;
+    int nextProcessID;
+    long long linesRead;
+    long long eventsParsed;
+    ObservedSummary summary;
+    
+    bool nextLine(const char*& begin, const char*& end);
+    void handleLine(const char* begin, const char* end, TraceSink& sink);
+    void handleSwitch(int cpu, long long ns, const char* payload, const char* end, TraceSink& sink);
+    void handleWakeup(long long ns, const char* payload, const char* end);
+    void openBurst(int pid, TaskState& task, long long ns);
+    void closeBurst(int pid, TaskState& task, long long ns, TraceSink& sink);
+    long long toTicks(long long ns) const;
+    
+public:
+    LinuxTraceImporter(std::istream& in, const TraceImportOptions& opts = TraceImportOptions());
+    
+    // Processes one line; returns false once the input is exhausted
+    bool pump(TraceSink& sink);
+    // Drains the whole input and closes bursts still running at the end
+    void importAll(TraceSink& sink);
+    void finish(TraceSink& sink);
+    
+    // Earliest arrival (in ticks) of a burst that has not completed yet, or the
+    // current trace time if none is open; later bursts cannot arrive before it
+    long long getArrivalWatermark() const;
+    long long getCurrentTick() const { return toTicks(lastTimestamp); }
+    
+    long long getLinesRead() const { return linesRead; }
+    long long getEventsParsed() const { return eventsParsed; }
+    const ObservedSummary& getObservedSummary() const { return summary; }
+};
+
+// Replays a kernel trace as an ArrivalStream in arrival order. Bursts finish
+// out of order, so completed ones are held until no open burst can precede
+// them, or for at most maxReorderDelay ticks.
+class LinuxTraceArrivalStream : public ArrivalStream, private TraceSink {
+private:
+    struct LaterArrival {
+        bool operator()(const std::shared_ptr<Process>& a, const std::shared_ptr<Process>& b) const {
+            if (a->getArrivalTime() == b->getArrivalTime()) {
+                return a->getProcessID() > b->getProcessID();
+            }
+            return a->getArrivalTime() > b->getArrivalTime();
+        }
+    };
+    
+    LinuxTraceImporter importer;
+    TraceSink* observer;
+    std::priority_queue<std::shared_ptr<Process>, std::vector<std::shared_ptr<Process>>,
+                        LaterArrival> reorderBuffer;
+    long long maxReorderDelay;
+    bool finished;
+    
+    void onBurst(const ObservedBurst& burst) override;
+    void onSegment(const ObservedSegment& segment) override;
+    
+public:
+    LinuxTraceArrivalStream(std::istream& in, const TraceImportOptions& opts = TraceImportOptions(),
+                            TraceSink* traceObserver = nullptr);
+    
+    std::shared_ptr<Process> next() override;
+    const LinuxTraceImporter& getImporter() const { return importer; }
+};
+
+#endif // LINUXTRACEIMPORTER_H
\ No newline at end of file
@@ -0,0 +1,294 @@
+#include "WorkloadGenerator.h"
+#include "AsyncWriter.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+
+// Processes per chunk; chunk boundaries fix the floating-point summation order
+static const size_t CHUNK_SIZE = 1 << 16;
+
+// Counter lanes, so per-process draws and regime draws never share a counter
+static const uint32_t LANE_PROCESS = 0;
+static const uint32_t LANE_REGIME = 1;
+static const uint32_t LANE_GAP = 2;
+
+Philox4x32::Philox4x32(uint64_t seed) {
+    key[0] = static_cast<uint32_t>(seed);
+    key[1] = static_cast<uint32_t>(seed >> 32);
+}
+
+void Philox4x32::generate(uint64_t index, uint32_t lane, uint32_t out[4]) const {
+    const uint32_t M0 = 0xD2511F53, M1 = 0xCD9E8D57;
+    const uint32_t W0 = 0x9E3779B9, W1 = 0xBB67AE85;
+    
+    uint32_t c0 = static_cast<uint32_t>(index), c1 = static_cast<uint32_t>(index >> 32);
+    uint32_t c2 = lane, c3 = 0;
+    uint32_t k0 = key[0], k1 = key[1];
+    for (int round = 0; round < 10; ++round) {
+        uint64_t p0 = static_cast<uint64_t>(M0) * c0;
+        uint64_t p1 = static_cast<uint64_t>(M1) * c2;
+        uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+        uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+        c1 = static_cast<uint32_t>(p1);
+        c3 = static_cast<uint32_t>(p0);
+        c0 = n0;
+        c2 = n2;
+        k0 += W0;
+        k1 += W1;
+    }
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+static double normalCDF(double z) {
+    return 0.5 * std::erfc(-z / std::sqrt(2.0));
+}
+
+// Acklam's rational approximation (relative error about 1e-9); only plain
+// arithmetic outside the tails
+double WorkloadGenerator::normalQuantile(double p) {
+    static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                               1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+    static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                               6.680131188771972e+01, -1.328068155288572e+01};
+    static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                               -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+    static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                               3.754408661907416e+00};
+    const double tail = 0.02425;
+    
+    if (p < tail || p > 1.0 - tail) {
+        double q = std::sqrt(-2.0 * std::log(p < tail ? p : 1.0 - p));
+        double x = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+                   ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+        return p < tail ? x : -x;
+    }
+    double q = p - 0.5;
+    double r = q * q;
+    return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+           (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+}
+
+static void validate(const WorkloadSpec& spec) {
+    if (spec.count < 0) {
+        throw std::invalid_argument("Workload size must not be negative");
+    }
+    if (spec.arrivalRate <= 0.0 || (spec.arrivals == ARRIVALS_MMPP && spec.burstArrivalRate <= 0.0)) {
+        throw std::invalid_argument("Arrival rates must be positive");
+    }
+    if (spec.arrivals == ARRIVALS_MMPP && (spec.meanCalmArrivals < 1.0 || spec.meanBurstArrivals < 1.0)) {
+        throw std::invalid_argument("MMPP regimes must last at least one arrival on average");
+    }
+    if (spec.meanBurst <= 0.0) {
+        throw std::invalid_argument("Mean burst time must be positive");
+    }
+    if (spec.bursts == BURSTS_PARETO && spec.burstShape <= 1.0) {
+        throw std::invalid_argument("Pareto bursts need a tail index above 1 for a finite mean");
+    }
+    if (spec.bursts == BURSTS_LOGNORMAL && spec.burstShape < 0.0) {
+        throw std::invalid_argument("Lognormal sigma must not be negative");
+    }
+    if (spec.maxPriority < 0 || std::fabs(spec.priorityCorrelation) > 1.0) {
+        throw std::invalid_argument("Priorities need maxPriority >= 0 and a correlation in [-1, 1]");
+    }
+}
+
+// MMPP regime runs, alternating calm (even) and burst (odd): runEnds[k] is one
+// past the last process of run k. Only the switches are drawn here, so this
+// sequential pass is short next to the per-process work.
+static std::vector<long long> regimeRuns(const WorkloadSpec& spec, const Philox4x32& rng) {
+    std::vector<long long> runEnds;
+    if (spec.arrivals != ARRIVALS_MMPP) return runEnds;
+    
+    long long end = 0;
+    for (uint64_t run = 0; end < spec.count; ++run) {
+        double mean = run % 2 == 0 ? spec.meanCalmArrivals : spec.meanBurstArrivals;
+        uint32_t words[4];
+        rng.generate(run, LANE_REGIME, words);
+        
+        // Geometric number of arrivals with the given mean, at least one
+        long long length = 1;
+        if (mean > 1.0) {
+            length += static_cast<long long>(std::log(Philox4x32::toUnit(words[0])) / std::log(1.0 - 1.0 / mean));
+        }
+        end += length;
+        runEnds.push_back(end);
+    }
+    return runEnds;
+}
+
+// Sequential reader over one lane: position n is word n % 4 of block n / 4, so
+// one Philox call serves four draws and a chunk can start at any position
+class UniformStream {
+private:
+    const Philox4x32& rng;
+    uint32_t lane;
+    uint64_t block;
+    uint32_t words[4];
+    
+public:
+    UniformStream(const Philox4x32& generator, uint32_t streamLane)
+        : rng(generator), lane(streamLane), block(UINT64_MAX) {}
+    
+    double at(uint64_t position) {
+        if (position / 4 != block) {
+            block = position / 4;
+            rng.generate(block, lane, words);
+        }
+        return Philox4x32::toUnit(words[position % 4]);
+    }
+};
+
+// Calls fn(index, rate) for each process of a chunk with its regime's arrival rate
+template <typename Fn>
+static void forEachInChunk(const WorkloadSpec& spec, const std::vector<long long>& runEnds,
+                           size_t begin, size_t end, Fn fn) {
+    if (spec.arrivals != ARRIVALS_MMPP) {
+        for (size_t i = begin; i < end; ++i) fn(i, spec.arrivalRate);
+        return;
+    }
+    size_t run = std::upper_bound(runEnds.begin(), runEnds.end(), static_cast<long long>(begin)) - runEnds.begin();
+    for (size_t i = begin; i < end; ++i) {
+        while (static_cast<long long>(i) >= runEnds[run]) run++;
+        fn(i, run % 2 == 0 ? spec.arrivalRate : spec.burstArrivalRate);
+    }
+}
+
+// Runs work(chunk) for every chunk over the worker threads
+template <typename Work>
+static void forEachChunk(size_t chunks, int threads, Work work) {
+    size_t workers = std::min(chunks, static_cast<size_t>(std::max(1, threads)));
+    if (workers <= 1) {
+        for (size_t chunk = 0; chunk < chunks; ++chunk) work(chunk);
+        return;
+    }
+    
+    std::atomic<size_t> nextChunk(0);
+    std::vector<std::thread> pool;
+    for (size_t w = 0; w < workers; ++w) {
+        pool.emplace_back([&]() {
+            for (size_t chunk = nextChunk++; chunk < chunks; chunk = nextChunk++) {
+                work(chunk);
+            }
+        });
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+}
+
+SyntheticWorkload WorkloadGenerator::generate(const WorkloadSpec& spec) {
+    validate(spec);
+    
+    const size_t count = static_cast<size_t>(spec.count);
+    const size_t chunks = (count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    const int threads = spec.threads > 0 ? spec.threads
+                                         : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    const Philox4x32 rng(spec.seed);
+    const std::vector<long long> runEnds = regimeRuns(spec, rng);
+    
+    // Lognormal parameters giving the requested mean; Pareto scale likewise
+    const double sigma = spec.burstShape;
+    const double mu = std::log(spec.meanBurst) - sigma * sigma / 2.0;
+    const double paretoScale = spec.meanBurst * (spec.burstShape - 1.0) / spec.burstShape;
+    const double rho = spec.priorityCorrelation;
+    const double rhoComplement = std::sqrt(1.0 - rho * rho);
+    
+    SyntheticWorkload workload;
+    workload.arrivalTimes.resize(count);
+    workload.burstTimes.resize(count);
+    workload.priorities.resize(count);
+    
+    // Pass 1: bursts, priorities and each chunk's total arrival span. Each
+    // quantity is an inverse CDF of its own uniform (two per process on the
+    // process lane, one on the gap lane); normal quantiles are only computed
+    // where a model needs them.
+    const bool correlated = rho != 0.0;
+    std::vector<double> chunkSpans(chunks, 0.0);
+    forEachChunk(chunks, threads, [&](size_t chunk) {
+        size_t begin = chunk * CHUNK_SIZE;
+        size_t end = std::min(count, begin + CHUNK_SIZE);
+        double span = 0.0;
+        UniformStream draws(rng, LANE_PROCESS);
+        UniformStream gaps(rng, LANE_GAP);
+        forEachInChunk(spec, runEnds, begin, end, [&](size_t i, double rate) {
+            double uBurst = draws.at(2 * i);
+            double uPriority = draws.at(2 * i + 1);
+            double zBurst = (correlated || spec.bursts == BURSTS_LOGNORMAL) ? normalQuantile(uBurst) : 0.0;
+            
+            // Every model is increasing in uBurst, so the copula below
+            // correlates priority with the burst whatever its distribution
+            double burst;
+            switch (spec.bursts) {
+                case BURSTS_LOGNORMAL: burst = std::exp(mu + sigma * zBurst); break;
+                case BURSTS_PARETO: burst = paretoScale * std::pow(1.0 - uBurst, -1.0 / spec.burstShape); break;
+                default: burst = -spec.meanBurst * std::log(1.0 - uBurst); break;
+            }
+            burst = std::min(std::max(1.0, std::round(burst)), static_cast<double>(INT_MAX));
+            if (spec.maxBurst > 0) burst = std::min(burst, static_cast<double>(spec.maxBurst));
+            workload.burstTimes[i] = static_cast<int>(burst);
+            
+            if (correlated) {
+                uPriority = normalCDF(rho * zBurst + rhoComplement * normalQuantile(uPriority));
+            }
+            int priority = static_cast<int>(uPriority * (spec.maxPriority + 1));
+            workload.priorities[i] = std::min(priority, spec.maxPriority);
+            
+            span += -std::log(gaps.at(i)) / rate;
+        });
+        chunkSpans[chunk] = span;
+    });
+    
+    std::vector<double> chunkStarts(chunks, 0.0);
+    double total = 0.0;
+    for (size_t chunk = 0; chunk < chunks; ++chunk) {
+        chunkStarts[chunk] = total;
+        total += chunkSpans[chunk];
+    }
+    if (total >= static_cast<double>(INT_MAX)) {
+        throw std::invalid_argument("Workload spans more time than the simulator can represent; raise the arrival rate");
+    }
+    
+    // Pass 2: arrival times from each chunk's offset, redrawing only the gaps
+    forEachChunk(chunks, threads, [&](size_t chunk) {
+        size_t begin = chunk * CHUNK_SIZE;
+        size_t end = std::min(count, begin + CHUNK_SIZE);
+        double time = chunkStarts[chunk];
+        UniformStream gaps(rng, LANE_GAP);
+        forEachInChunk(spec, runEnds, begin, end, [&](size_t i, double rate) {
+            time += -std::log(gaps.at(i)) / rate;
+            workload.arrivalTimes[i] = static_cast<int>(time);
+        });
+    });
+    
+    return workload;
+}
+
+std::vector<std::shared_ptr<Process>> SyntheticWorkload::toProcesses() const {
+    std::vector<std::shared_ptr<Process>> processes;
+    processes.reserve(size());
+    for (size_t i = 0; i < size(); ++i) {
+        int id = static_cast<int>(i + 1);
+        processes.push_back(std::make_shared<Process>(id, arrivalTimes[i], burstTimes[i], priorities[i],
+                                                      "P" + std::to_string(id)));
+    }
+    return processes;
+}
+
+bool SyntheticWorkload::saveToFile(const std::string& filename) const {
+    AsyncWriter file(filename);
+    if (!file.isOpen()) return false;
+    
+    file << "# ProcessID ArrivalTime BurstTime Priority ProcessName [Width]\n";
+    for (size_t i = 0; i < size(); ++i) {
+        long long id = static_cast<long long>(i + 1);
+        file << id << ' ' << arrivalTimes[i] << ' ' << burstTimes[i] << ' '
+             << priorities[i] << " P" << id << " 1\n";
+    }
+    return file.close();
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+#ifndef WORKLOADGENERATOR_H
+#define WORKLOADGENERATOR_H
+
+#include "../Process.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Philox4x32-10 counter-based generator: the random numbers for a counter
+// depend only on (key, counter), so any element of a workload can be drawn
+// independently of the others and in any order.
+struct Philox4x32 {
+    uint32_t key[2];
+    
+    explicit Philox4x32(uint64_t seed);
+    
+    // Four independent 32-bit words for one counter
+    void generate(uint64_t index, uint32_t lane, uint32_t out[4]) const;
+    
+    // Maps a word to the open interval (0, 1)
+    static double toUnit(uint32_t word) { return (word + 0.5) * (1.0 / 4294967296.0); }
+};
+
+enum ArrivalModel {
+    ARRIVALS_POISSON,   // exponential gaps at arrivalRate
+    ARRIVALS_MMPP       // two-state Markov-modulated Poisson: calm and burst regimes
+};
+
+enum BurstModel {
+    BURSTS_EXPONENTIAL,
+    BURSTS_LOGNORMAL,   // burstShape is sigma of the underlying normal
+    BURSTS_PARETO       // burstShape is the tail index alpha (> 1)
+};
+
+struct WorkloadSpec {
+    uint64_t seed = 1;
+    long long count = 1000;
+    
+    ArrivalModel arrivals = ARRIVALS_POISSON;
+    double arrivalRate = 0.5;           // processes per time unit (MMPP: calm regime)
+    double burstArrivalRate = 4.0;      // MMPP: rate in the burst regime
+    double meanCalmArrivals = 200.0;    // MMPP: mean arrivals per calm regime
+    double meanBurstArrivals = 50.0;    // MMPP: mean arrivals per burst regime
+    
+    BurstModel bursts = BURSTS_EXPONENTIAL;
+    double meanBurst = 10.0;
+    double burstShape = 1.0;
+    int maxBurst = 0;                   // 0 = no cap
+    
+    // Priorities 0..maxPriority; a positive correlation gives longer bursts
+    // numerically larger (i.e. lower) priorities, through a Gaussian copula
+    int maxPriority = 10;
+    double priorityCorrelation = 0.0;
+    
+    int threads = 0;                    // 0 = all hardware threads
+};
+
+// Generated workload as plain columns, one entry per process; process i has
+// ID i + 1 and name "P<i + 1>"
+struct SyntheticWorkload {
+    std::vector<int> arrivalTimes;
+    std::vector<int> burstTimes;
+    std::vector<int> priorities;
+    
+    size_t size() const { return arrivalTimes.size(); }
+    std::vector<std::shared_ptr<Process>> toProcesses() const;
+    bool saveToFile(const std::string& filename) const;
+};
+
+// Fills the columns in fixed-size chunks spread over worker threads. Every
+// draw is keyed by the process index, and floating-point sums follow chunk
+// boundaries, so the result depends on the seed only, never on the thread
+// count.
+class WorkloadGenerator {
+public:
+    static SyntheticWorkload generate(const WorkloadSpec& spec);
+    
+    // Inverse of the standard normal CDF, for p in (0, 1)
+    static double normalQuantile(double p);
+};
+
+#endif // WORKLOADGENERATOR_H
\ No newline at end of file
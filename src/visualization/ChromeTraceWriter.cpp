@@ -0,0 +1,75 @@
+#include "ChromeTraceWriter.h"
+
+// Track 0 of each run holds arrivals; CPU i is track i + 1
+ChromeTraceWriter::ChromeTraceWriter(const std::string& filename, long long micros, bool backgroundThread)
+    : file(filename, backgroundThread), microsPerTick(micros > 0 ? micros : 1), runs(0),
+      firstEvent(true), lastWaiting(0), lastRunning(0) {
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+}
+
+void ChromeTraceWriter::beginEvent(const char* phase, const std::string& name, int track, long long timestamp) {
+    file << (firstEvent ? "\n" : ",\n");
+    firstEvent = false;
+    file << "{\"ph\":\"" << phase << "\",\"name\":";
+    RecordWriter::writeJSONString(file, name);
+    file << ",\"pid\":" << runs << ",\"tid\":" << track << ",\"ts\":" << timestamp;
+}
+
+void ChromeTraceWriter::writeMetadata(const char* kind, int track, const std::string& name) {
+    beginEvent("M", kind, track, 0);
+    file << ",\"args\":{\"name\":";
+    RecordWriter::writeJSONString(file, name);
+    file << "}}";
+}
+
+void ChromeTraceWriter::onRunStart(const Scheduler& scheduler) {
+    runs++;
+    writeMetadata("process_name", 0, scheduler.getAlgorithmName());
+    writeMetadata("thread_name", 0, "Arrivals");
+    for (int cpu = 0; cpu < scheduler.getNumCPUs(); ++cpu) {
+        writeMetadata("thread_name", cpu + 1, "CPU " + std::to_string(cpu));
+    }
+    sliceStarts.assign(scheduler.getNumCPUs(), 0);
+    lastWaiting = static_cast<size_t>(-1);
+    lastRunning = static_cast<size_t>(-1);
+}
+
+void ChromeTraceWriter::onArrival(int time, const Process& process) {
+    beginEvent("i", process.getProcessName(), 0, timestamp(time));
+    file << ",\"s\":\"t\",\"args\":{\"burst\":" << process.getBurstTime()
+         << ",\"priority\":" << process.getPriority() << "}}";
+}
+
+void ChromeTraceWriter::onDispatch(int time, int cpuID, const Process&) {
+    sliceStarts[cpuID] = time;
+}
+
+// Slices are written whole when they end, as complete ("X") events
+void ChromeTraceWriter::onRelease(int time, int cpuID, const Process& process, bool completed) {
+    int start = sliceStarts[cpuID];
+    if (time > start) {
+        beginEvent("X", process.getProcessName(), cpuID + 1, timestamp(start));
+        file << ",\"dur\":" << timestamp(time - start)
+             << ",\"args\":{\"id\":" << process.getProcessID()
+             << ",\"remaining\":" << process.getRemainingTime() << "}}";
+    }
+    if (!completed) {
+        beginEvent("i", "Preempt " + process.getProcessName(), cpuID + 1, timestamp(time));
+        file << ",\"s\":\"t\"}";
+    }
+}
+
+// Counters only change on a few ticks, so only changes are written
+void ChromeTraceWriter::onTick(int time, size_t waiting, size_t running) {
+    if (waiting == lastWaiting && running == lastRunning) return;
+    beginEvent("C", "Processes", 0, timestamp(time));
+    file << ",\"args\":{\"waiting\":" << static_cast<long long>(waiting)
+         << ",\"running\":" << static_cast<long long>(running) << "}}";
+    lastWaiting = waiting;
+    lastRunning = running;
+}
+
+bool ChromeTraceWriter::close() {
+    file << "\n]}\n";
+    return file.close();
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#ifndef CHROMETRACEWRITER_H
+#define CHROMETRACEWRITER_H
+
+#include "../Scheduler.h"
+#include "../utils/AsyncWriter.h"
+#include <string>
+#include <vector>
+
+// Streams runs as Chrome Trace Event JSON, which Perfetto (ui.perfetto.dev) and
+// chrome://tracing open. Each run is a trace process named after its algorithm
+// with one track per CPU carrying a slice per stretch a process ran, instant
+// events for preemptions, an arrivals track, and counter tracks for waiting and
+// running processes. Events are written as they happen; only the start of the
+// slice open on each CPU is kept, so traces of any length fit in memory.
+class ChromeTraceWriter : public ScheduleObserver {
+private:
+    AsyncWriter file;
+    long long microsPerTick;
+    int runs;
+    bool firstEvent;
+    std::vector<int> sliceStarts;
+    size_t lastWaiting;
+    size_t lastRunning;
+    
+    void beginEvent(const char* phase, const std::string& name, int track, long long timestamp);
+    void writeMetadata(const char* kind, int track, const std::string& name);
+    long long timestamp(int time) const { return time * microsPerTick; }
+    
+public:
+    // One simulated time unit spans microsPerTick microseconds of trace time
+    explicit ChromeTraceWriter(const std::string& filename, long long microsPerTick = 1000,
+                               bool backgroundThread = false);
+    
+    bool isOpen() const { return file.isOpen(); }
+    
+    void onRunStart(const Scheduler& scheduler) override;
+    void onArrival(int time, const Process& process) override;
+    void onDispatch(int time, int cpuID, const Process& process) override;
+    void onRelease(int time, int cpuID, const Process& process, bool completed) override;
+    void onTick(int time, size_t waiting, size_t running) override;
+    
+    // Ends the JSON document; returns false if any write failed
+    bool close();
+};
+
+#endif // CHROMETRACEWRITER_H
\ No newline at end of file
@@ -1,7 +1,8 @@
 #include "GanttChart.h"
+#include "../core/TraceIndex.h"
+#include "../utils/AsyncWriter.h"
 #include <iostream>
 #include <iomanip>
-#include <fstream>
 #include <algorithm>
 
 void GanttChart::printAdvancedGanttChart(const std::vector<std::shared_ptr<Process>>& processes,
@@ -21,6 +22,26 @@ void GanttChart::printAdvancedGanttChart(const std::vector<std::shared_ptr<Proce
         printProcessTimeline(process, maxTime);
     }
     
+    // Then what each CPU ran, slot by slot
+    std::cout << std::string(maxTime * 3 + 10, '-') << std::endl;
+    TraceIndex index(processes, numCPUs);
+    for (int cpu = 0; cpu < numCPUs; ++cpu) {
+        std::cout << std::setw(8) << ("CPU " + std::to_string(cpu));
+        int t = 0;
+        for (const TraceSpan& span : index.overlapping(cpu, 0, maxTime + 1)) {
+            for (; t < span.start; ++t) {
+                std::cout << std::setw(3) << ".";
+            }
+            for (; t < span.end && t <= maxTime; ++t) {
+                std::cout << std::setw(3) << span.process->getProcessName().substr(0, 2);
+            }
+        }
+        for (; t <= maxTime; ++t) {
+            std::cout << std::setw(3) << ".";
+        }
+        std::cout << std::endl;
+    }
+    
     std::cout << std::string(maxTime * 3 + 10, '-') << std::endl;
 }
 
@@ -44,10 +65,7 @@ void GanttChart::printProcessTimeline(const std::shared_ptr<Process>& process, i
     std::vector<bool> timeline(maxTime + 1, false);
     
     for (const auto& execution : process->getExecutionHistory()) {
-        int startTime = execution.first;
-        int duration = execution.second;
-        
-        for (int t = startTime; t < startTime + duration && t <= maxTime; ++t) {
+        for (int t = execution.start; t < execution.end() && t <= maxTime; ++t) {
             timeline[t] = true;
         }
     }
@@ -66,28 +84,67 @@ void GanttChart::printProcessTimeline(const std::shared_ptr<Process>& process, i
 
 void GanttChart::saveGanttChartToFile(const std::vector<std::shared_ptr<Process>>& processes,
                                      int numCPUs, const std::string& filename) {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
+    AsyncWriter file(filename);
+    if (!file.isOpen()) {
         std::cerr << "Error: Could not open file " << filename << std::endl;
         return;
     }
     
-    int maxTime = 0;
-    for (const auto& process : processes) {
-        maxTime = std::max(maxTime, process->getCompletionTime());
+    TraceIndex index(processes, numCPUs);
+    if (RecordWriter::formatForFile(filename) == FORMAT_JSONL) {
+        // One record per execution interval, CPU by CPU in time order
+        RecordWriter records(file, FORMAT_JSONL, {"cpu", "process", "start", "end"});
+        for (int cpu = 0; cpu < numCPUs; ++cpu) {
+            for (const TraceSpan& span : index.overlapping(cpu, 0, index.getEndTime())) {
+                records.field(cpu)
+                       .field(span.process->getProcessName())
+                       .field(span.start)
+                       .field(span.end);
+                records.endRecord();
+            }
+        }
+    } else {
+        // Each process's own history, so processes sharing an ID stay apart
+        file << "Gantt Chart Data\n";
+        file << "Process,ExecutionIntervals\n";
+        
+        for (const auto& process : processes) {
+            file << process->getProcessName() << ",";
+            for (const auto& slice : process->getExecutionHistory()) {
+                file << "[" << slice.start << "-" << slice.end() << "]";
+            }
+            file << '\n';
+        }
     }
     
-    file << "Gantt Chart Data" << std::endl;
-    file << "Process,ExecutionIntervals" << std::endl;
+    if (!file.close()) {
+        std::cerr << "Error: Could not write file " << filename << std::endl;
+        return;
+    }
+    std::cout << "Gantt chart saved to " << filename << std::endl;
+}
+
+void GanttChart::saveCPUTimelineToFile(const std::vector<std::shared_ptr<Process>>& processes,
+                                       int numCPUs, const std::string& filename) {
+    AsyncWriter file(filename);
+    if (!file.isOpen()) {
+        std::cerr << "Error: Could not open file " << filename << std::endl;
+        return;
+    }
     
-    for (const auto& process : processes) {
-        file << process->getProcessName() << ",";
-        for (const auto& execution : process->getExecutionHistory()) {
-            file << "[" << execution.first << "-" << (execution.first + execution.second) << "]";
+    TraceIndex index(processes, numCPUs);
+    file << "CPU,ExecutionIntervals\n";
+    for (int cpu = 0; cpu < numCPUs; ++cpu) {
+        file << "CPU " << cpu << ",";
+        for (const TraceSpan& span : index.overlapping(cpu, 0, index.getEndTime())) {
+            file << "[" << span.start << "-" << span.end << " " << span.process->getProcessName() << "]";
         }
-        file << std::endl;
+        file << '\n';
     }
     
-    file.close();
-    std::cout << "Gantt chart saved to " << filename << std::endl;
+    if (!file.close()) {
+        std::cerr << "Error: Could not write file " << filename << std::endl;
+        return;
+    }
+    std::cout << "CPU timeline saved to " << filename << std::endl;
 }
\ No newline at end of file
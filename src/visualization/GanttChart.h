@@ -14,6 +14,10 @@ public:
     static void saveGanttChartToFile(const std::vector<std::shared_ptr<Process>>& processes,
                                     int numCPUs, const std::string& filename);
     
+    // What each CPU ran, one CSV row per CPU: "[start-end name]" intervals
+    static void saveCPUTimelineToFile(const std::vector<std::shared_ptr<Process>>& processes,
+                                      int numCPUs, const std::string& filename);
+    
     static void printTimelineHeader(int maxTime);
     static void printProcessTimeline(const std::shared_ptr<Process>& process, int maxTime);
 };